@@ -1,83 +1,437 @@
 #include <iostream>
 #include <string>
 #include <sstream>
-#include <set>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <thread>
 
 /*
 Author: Arati Ganesh
 Class: ECE6122
-Last Date Modified: 08/29/23
+Last Date Modified: 10/18/26
 Description:
 This code inputs a natural number from the user and outputs
-the multiples of 3 or 5 less than the entered number and the 
-sum of those multiples.
+the sum of the multiples of a set of divisors (3 and 5 by default)
+less than the entered number. The sum is computed in closed form by
+inclusion-exclusion over the least common multiples of the divisors,
+so the work depends only on the number of divisors, not on the limit.
+The multiples themselves are only listed when enumeration is requested.
+
+Usage: Lab0_Problem2 [-d 3,5,...] [-e] [-o file]
+    -d  comma separated divisor set (default 3,5)
+    -e  also list the multiples below the entered number
+    -o  write the list to a file instead of the terminal (implies -e)
+*/
+
+// 128-bit accumulator: the sum of multiples below a 64-bit limit is below 2^127
+typedef unsigned __int128 uint128;
+
+/*
+    This Function converts a 128-bit unsigned value to decimal text.
+*/
+
+std::string toString(uint128 value)
+{
+    char buffer[40];
+    int pos = sizeof(buffer);
+    do
+    {
+        buffer[--pos] = static_cast<char>('0' + static_cast<int>(value % 10));
+        value /= 10;
+    } while (value != 0);
+    return std::string(buffer + pos, sizeof(buffer) - pos);
+}
+
+/*
+    This Function returns the sum of the multiples of step below the limit,
+    step * m * (m + 1) / 2 with m = (limit - 1) / step. The even factor is
+    halved first so the product never leaves 128 bits.
+*/
+
+uint128 sumOfMultiplesOf(uint64_t lastNumber, uint64_t step)
+{
+    if (lastNumber == 0 || step >= lastNumber)
+    {
+        return 0;
+    }
+    uint128 m = (lastNumber - 1) / step;
+    uint128 triangle = (m % 2 == 0) ? (m / 2) * (m + 1) : m * ((m + 1) / 2);
+    return triangle * step;
+}
+
+/*
+    This Function returns the greatest common divisor of two numbers.
+*/
+
+uint64_t gcd(uint64_t a, uint64_t b)
+{
+    while (b != 0)
+    {
+        uint64_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/*
+    This Function removes zeros and duplicates from the divisor set, and drops any
+    divisor that is a multiple of another one since its multiples are already counted.
+*/
+
+std::vector<uint64_t> reduceDivisors(std::vector<uint64_t> divisors)
+{
+    divisors.erase(std::remove(divisors.begin(), divisors.end(), 0), divisors.end());
+    std::sort(divisors.begin(), divisors.end());
+    divisors.erase(std::unique(divisors.begin(), divisors.end()), divisors.end());
+
+    std::vector<uint64_t> reduced;
+    for (uint64_t divisor : divisors)
+    {
+        bool redundant = false;
+        for (uint64_t kept : reduced)
+        {
+            if (divisor % kept == 0)
+            {
+                redundant = true;
+                break;
+            }
+        }
+        if (!redundant)
+        {
+            reduced.push_back(divisor);
+        }
+    }
+    return reduced;
+}
+
+/*
+    This Function walks the subsets of divisors[index..] depth first, adding the sum of
+    multiples of each subset LCM with sign (-1)^(|subset| + 1). Once an LCM reaches the
+    limit every superset contributes nothing, so that branch is cut.
 */
 
+void inclusionExclusion(uint64_t lastNumber, const std::vector<uint64_t>& divisors, size_t index,
+                        uint64_t currentLcm, bool positive, uint128& total)
+{
+    for (size_t i = index; i < divisors.size(); ++i)
+    {
+        uint64_t factor = divisors[i] / gcd(currentLcm, divisors[i]);
+        // LCM would reach the limit (or overflow 64 bits); nothing below the limit is a multiple
+        if (currentLcm > (lastNumber - 1) / factor)
+        {
+            continue;
+        }
+        uint64_t lcm = currentLcm * factor;
+
+        // Unsigned wrap-around on subtraction is exact: the final total is below 2^128
+        if (positive)
+        {
+            total += sumOfMultiplesOf(lastNumber, lcm);
+        }
+        else
+        {
+            total -= sumOfMultiplesOf(lastNumber, lcm);
+        }
+        inclusionExclusion(lastNumber, divisors, i + 1, lcm, !positive, total);
+    }
+}
+
+/*
+    This Function returns the sum of every number below the limit that is
+    a multiple of at least one divisor, in O(2^k) work for k divisors.
+*/
+
+uint128 findMultiplesSum(uint64_t lastNumber, const std::vector<uint64_t>& divisors)
+{
+    uint128 total = 0;
+    if (lastNumber > 1)
+    {
+        inclusionExclusion(lastNumber, reduceDivisors(divisors), 0, 1, true, total);
+    }
+    return total;
+}
+
+// Two-character decimal digits of 0..99 for the number formatter
+static const char DIGIT_PAIRS[] =
+    "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+    "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+// Numbers per segment; every thread formats one segment per round
+const uint64_t SEGMENT_LENGTH = 1 << 20;
+
+/*
+    This Function writes the decimal text of value at out, two digits per
+    division, and returns the position after the last digit.
+*/
+
+inline char* writeNumber(char* out, uint64_t value)
+{
+    char digits[20];
+    char* end = digits + sizeof(digits);
+    char* pos = end;
+    while (value >= 100)
+    {
+        unsigned remainder = static_cast<unsigned>(value % 100);
+        value /= 100;
+        pos -= 2;
+        std::memcpy(pos, DIGIT_PAIRS + 2 * remainder, 2);
+    }
+    if (value >= 10)
+    {
+        pos -= 2;
+        std::memcpy(pos, DIGIT_PAIRS + 2 * value, 2);
+    }
+    else
+    {
+        *--pos = static_cast<char>('0' + value);
+    }
+    std::memcpy(out, pos, end - pos);
+    return out + (end - pos);
+}
+
 /*
-    This Functions finds all the multiples under the limit. 
-    It stores the unique numbers and returns the sum of multiples.
+    This Function formats the multiples in [start, end) as ", m" records.
+    Every divisor keeps its next multiple in the segment and the smallest
+    one is written once per step, so no set is needed to remove duplicates.
 */
 
-int findMultiplesAndSum(int lastNumber, int divisor, std::set<int>& multiples)
+void fillSegment(uint64_t start, uint64_t end, const std::vector<uint64_t>& steps, int numDigits,
+                 std::vector<char>& buffer, size_t& length)
 {
-    int multipleSum = 0;
-    std::cout << "The multiples of " << divisor << " below " << lastNumber << " are: ";
-    for (int count = divisor; count < lastNumber; count += divisor)
+    // Upper bound on the multiples in the segment, for the buffer size
+    uint64_t segmentLength = end - start;
+    uint64_t bound = 0;
+    std::vector<uint64_t> next(steps.size());
+    for (size_t i = 0; i < steps.size(); ++i)
+    {
+        bound += segmentLength / steps[i] + 1;
+        uint64_t offset = (steps[i] - start % steps[i]) % steps[i];
+        next[i] = (offset >= end - start) ? end : start + offset;
+    }
+    bound = std::min(bound, segmentLength);
+    if (buffer.size() < bound * (numDigits + 2))
+    {
+        buffer.resize(bound * (numDigits + 2));
+    }
+
+    char* out = buffer.data();
+    while (true)
     {
-        std::cout << count << ", ";
-        //Check if it exists in the set
-        if (multiples.find(count) == multiples.end()) 
+        uint64_t smallest = end;
+        for (uint64_t value : next)
+        {
+            smallest = std::min(smallest, value);
+        }
+        if (smallest >= end)
+        {
+            break;
+        }
+
+        *out++ = ',';
+        *out++ = ' ';
+        out = writeNumber(out, smallest);
+
+        for (size_t i = 0; i < steps.size(); ++i)
         {
-            multipleSum += count;
-            multiples.insert(count);
+            if (next[i] == smallest)
+            {
+                next[i] = (end - smallest > steps[i]) ? smallest + steps[i] : end;
+            }
         }
     }
-    //Delete the last comma
-    if (multipleSum != 0) 
+    length = out - buffer.data();
+}
+
+/*
+    This Function lists the multiples below the limit in increasing order.
+    The range is cut into segments that the threads format in parallel into
+    their own buffers; while one round is written out in segment order the
+    next round is already being formatted.
+*/
+
+void printMultiples(uint64_t lastNumber, const std::vector<uint64_t>& divisors, FILE* out)
+{
+    std::vector<uint64_t> steps = reduceDivisors(divisors);
+    unsigned numThreads = std::max(1u, std::thread::hardware_concurrency());
+    int numDigits = static_cast<int>(toString(lastNumber).size());
+
+    // Two sets of buffers: one being written while the other is filled
+    std::vector<std::vector<char>> buffers[2] = {std::vector<std::vector<char>>(numThreads), std::vector<std::vector<char>>(numThreads)};
+    std::vector<size_t> lengths[2] = {std::vector<size_t>(numThreads, 0), std::vector<size_t>(numThreads, 0)};
+    std::vector<std::thread> threads[2] = {std::vector<std::thread>(numThreads), std::vector<std::thread>(numThreads)};
+    uint64_t nextStart = 1;
+
+    auto launchRound = [&](int set)
+    {
+        for (unsigned t = 0; t < numThreads; ++t)
+        {
+            lengths[set][t] = 0;
+            if (nextStart >= lastNumber)
+            {
+                continue;
+            }
+            uint64_t start = nextStart;
+            uint64_t end = (lastNumber - start > SEGMENT_LENGTH) ? start + SEGMENT_LENGTH : lastNumber;
+            threads[set][t] = std::thread(fillSegment, start, end, std::cref(steps), numDigits,
+                                          std::ref(buffers[set][t]), std::ref(lengths[set][t]));
+            nextStart = end;
+        }
+    };
+
+    std::fprintf(out, "The multiples below %s are: ", toString(lastNumber).c_str());
+    bool first = true;
+    int current = 0;
+    launchRound(current);
+    while (true)
     {
-        std::cout << "\b\b";  
+        for (auto& thread : threads[current])
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+
+        bool more = nextStart < lastNumber;
+        if (more)
+        {
+            launchRound(1 - current);
+        }
+
+        for (unsigned t = 0; t < numThreads; ++t)
+        {
+            const char* data = buffers[current][t].data();
+            size_t length = lengths[current][t];
+            // Drop the separator in front of the very first multiple
+            if (first && length > 0)
+            {
+                data += 2;
+                length -= 2;
+                first = false;
+            }
+            std::fwrite(data, 1, length, out);
+        }
+
+        if (!more)
+        {
+            break;
+        }
+        current = 1 - current;
     }
+    std::fputs(".\n", out);
+    std::fflush(out);
+}
 
-    std::cout << "." << std::endl;
-    return multipleSum;
+/*
+    This Function parses a comma separated list of natural numbers.
+*/
+
+bool parseDivisors(const std::string& text, std::vector<uint64_t>& divisors)
+{
+    divisors.clear();
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        if (item.empty() || item.find_first_not_of("0123456789") != std::string::npos)
+        {
+            return false;
+        }
+        std::stringstream itemStream(item);
+        uint64_t value;
+        if (!(itemStream >> value) || value == 0)
+        {
+            return false;
+        }
+        divisors.push_back(value);
+    }
+    return !divisors.empty();
 }
 
-int main() 
+int main(int argc, char* argv[])
 {
-    while (1) 
+    std::vector<uint64_t> divisors = {3, 5};
+    bool enumerate = false;
+    FILE* listOutput = stdout;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+        {
+            if (!parseDivisors(argv[++i], divisors))
+            {
+                std::cerr << "Divisors should be a comma separated list of natural numbers." << std::endl;
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[i], "-e") == 0)
+        {
+            enumerate = true;
+        }
+        else if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+        {
+            listOutput = std::fopen(argv[++i], "w");
+            if (listOutput == nullptr)
+            {
+                std::cerr << "Could not open " << argv[i] << " for writing." << std::endl;
+                return 1;
+            }
+            enumerate = true;
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [-d 3,5,...] [-e] [-o file]" << std::endl;
+            return 1;
+        }
+    }
+
+    while (1)
     {
         std::cout << "Please enter a natural number (0 to quit): ";
         std::string inputNumString;
-        std::getline(std::cin, inputNumString);
+        if (!std::getline(std::cin, inputNumString))
+        {
+            break;
+        }
         std::stringstream ss(inputNumString);
 
-        int inputNum;
-        if (ss >> inputNum && inputNum >= 0) {
+        // Only plain digits are accepted so negative input does not wrap around
+        uint64_t inputNum;
+        std::string digits;
+        if (ss >> digits && digits.find_first_not_of("0123456789") == std::string::npos &&
+            std::stringstream(digits) >> inputNum) {
             //Exit the program when 0 is encountered
-            if (inputNum == 0) 
+            if (inputNum == 0)
             {
                 std::cout << "Program terminated." << std::endl;
                 break;
-            } 
-            else 
+            }
+            else
             {
-                int multipleSum = 0;
-                // Use a Set to store only unique multiples to prevent double counting
-                std::set<int> multiples;
-
-                multipleSum += findMultiplesAndSum(inputNum, 3, multiples);
-                multipleSum += findMultiplesAndSum(inputNum, 5, multiples);
+                if (enumerate)
+                {
+                    printMultiples(inputNum, divisors, listOutput);
+                }
 
-                std::cout << "The sum of all multiples is: " << multipleSum << "." << std::endl;
+                std::cout << "The sum of all multiples is: " << toString(findMultiplesSum(inputNum, divisors)) << "." << std::endl;
             }
-        } 
-        else 
+        }
+        else
         {
             //Reprompt the user when the input not a number
             continue;
         }
     }
 
+    if (listOutput != stdout)
+    {
+        std::fclose(listOutput);
+    }
+
     std::cout << "Have a nice day!" << std::endl;
     return 0;
 }
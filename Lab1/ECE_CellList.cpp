@@ -0,0 +1,252 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Contains the cutoff-radius cell-list evaluator. Charges are counting-sorted into a uniform bucket
+grid; probes and charges only visit the 27 cells around their own, so a fixed cutoff gives O(N) work.
+*/
+
+#include "ECE_CellList.h"
+#include <thread>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+constexpr double K = 9e9;  // Coulomb's Constant
+
+// Bucket the charges into cells of at least the cutoff radius.
+ECE_CellList::ECE_CellList(const ChargeArrays& charges, double cutoff, bool shiftedForce)
+    : charges(charges), cutoff(cutoff), cutoff2(cutoff * cutoff), shiftedForce(shiftedForce),
+      minX(0.0), minY(0.0), minZ(0.0), cellSize(cutoff), nx(1), ny(1), nz(1) {
+    size_t n = charges.size();
+    double maxX = 0.0, maxY = 0.0, maxZ = 0.0;
+    if (n > 0) {
+        minX = *std::min_element(charges.x.begin(), charges.x.end());
+        minY = *std::min_element(charges.y.begin(), charges.y.end());
+        minZ = *std::min_element(charges.z.begin(), charges.z.end());
+        maxX = *std::max_element(charges.x.begin(), charges.x.end());
+        maxY = *std::max_element(charges.y.begin(), charges.y.end());
+        maxZ = *std::max_element(charges.z.begin(), charges.z.end());
+    }
+
+    // Cells may be larger than the cutoff; grow them if a sparse set would need too many empty cells
+    const double maxCells = std::max(64.0, 8.0 * n);
+    while (true) {
+        double cx = std::floor((maxX - minX) / cellSize) + 1;
+        double cy = std::floor((maxY - minY) / cellSize) + 1;
+        double cz = std::floor((maxZ - minZ) / cellSize) + 1;
+        if (cx * cy * cz <= maxCells) {
+            nx = static_cast<int>(cx);
+            ny = static_cast<int>(cy);
+            nz = static_cast<int>(cz);
+            break;
+        }
+        cellSize *= 2.0;
+    }
+
+    // Counting sort of the charges by cell
+    int numCells = nx * ny * nz;
+    std::vector<int> cellOfCharge(n);
+    cellStart.assign(numCells + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        cellOfCharge[i] = cellOf(charges.x[i], charges.y[i], charges.z[i]);
+        ++cellStart[cellOfCharge[i] + 1];
+    }
+    for (int c = 0; c < numCells; ++c) {
+        cellStart[c + 1] += cellStart[c];
+    }
+    std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+    sortedIndex.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        sortedIndex[fill[cellOfCharge[i]]++] = static_cast<int>(i);
+    }
+}
+
+// Cell coordinates of a position, clamped to the grid.
+void ECE_CellList::cellCoordinates(double x, double y, double z, int &cx, int &cy, int &cz) const {
+    cx = std::min(nx - 1, std::max(0, static_cast<int>(std::floor((x - minX) / cellSize))));
+    cy = std::min(ny - 1, std::max(0, static_cast<int>(std::floor((y - minY) / cellSize))));
+    cz = std::min(nz - 1, std::max(0, static_cast<int>(std::floor((z - minZ) / cellSize))));
+}
+
+// Cell index of a position, clamped to the grid.
+int ECE_CellList::cellOf(double x, double y, double z) const {
+    int cx, cy, cz;
+    cellCoordinates(x, y, z, cx, cy, cz);
+    return (cz * ny + cy) * nx + cx;
+}
+
+// Scalar factor s(r) with F = s * d and the pair energy for a pair at squared distance r2.
+// The shifted-force form uses F(r) = kqq (1/r^2 - 1/rc^2) and V(r) = kqq (1/r - 1/rc + (r - rc)/rc^2).
+void ECE_CellList::pairTerms(double kqq, double r2, double &s, double &energy) const {
+    double r = std::sqrt(r2);
+    double invR = 1.0 / r;
+    if (shiftedForce) {
+        double invRc = 1.0 / cutoff;
+        s = kqq * (invR * invR - invRc * invRc) * invR;
+        energy = kqq * (invR - invRc + (r - cutoff) * invRc * invRc);
+    } else {
+        s = kqq * invR * invR * invR;
+        energy = kqq * invR;
+    }
+}
+
+// Field at one probe point.
+FieldSample ECE_CellList::fieldAt(const Point3D& probe) const {
+    FieldSample field = {0.0, 0.0, 0.0};
+    int cx, cy, cz;
+    cellCoordinates(probe.x, probe.y, probe.z, cx, cy, cz);
+
+    for (int z = std::max(0, cz - 1); z <= std::min(nz - 1, cz + 1); ++z) {
+        for (int y = std::max(0, cy - 1); y <= std::min(ny - 1, cy + 1); ++y) {
+            for (int x = std::max(0, cx - 1); x <= std::min(nx - 1, cx + 1); ++x) {
+                int cell = (z * ny + y) * nx + x;
+                for (int k = cellStart[cell]; k < cellStart[cell + 1]; ++k) {
+                    int j = sortedIndex[k];
+                    double dx = probe.x - charges.x[j];
+                    double dy = probe.y - charges.y[j];
+                    double dz = probe.z - charges.z[j];
+                    double r2 = dx * dx + dy * dy + dz * dz;
+                    if (r2 >= cutoff2 || r2 == 0.0) {
+                        continue;
+                    }
+                    double s, energy;
+                    pairTerms(K * charges.q[j], r2, s, energy);
+                    field.Ex += s * dx;
+                    field.Ey += s * dy;
+                    field.Ez += s * dz;
+                }
+            }
+        }
+    }
+
+    return field;
+}
+
+// Field at every probe point, split across numThreads threads.
+std::vector<FieldSample> ECE_CellList::computeFieldAt(const std::vector<Point3D>& probes, int numThreads) const {
+    std::vector<FieldSample> fields(probes.size());
+    if (probes.empty()) {
+        return fields;
+    }
+
+    auto ranges = calculateDataDistribution(static_cast<int>(probes.size()), std::max(1, numThreads));
+    std::vector<std::thread> threads(ranges.size());
+    for (size_t t = 0; t < ranges.size(); ++t) {
+        threads[t] = std::thread([this, &probes, &fields](int start, int end) {
+            for (int p = start; p < end; ++p) {
+                fields[p] = fieldAt(probes[p]);
+            }
+        }, ranges[t].start, ranges[t].end);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return fields;
+}
+
+// Field at one probe point from every charge within the cutoff, without the cell grid.
+FieldSample ECE_CellList::computeFieldDirect(const Point3D& probe) const {
+    FieldSample field = {0.0, 0.0, 0.0};
+    for (size_t j = 0; j < charges.size(); ++j) {
+        double dx = probe.x - charges.x[j];
+        double dy = probe.y - charges.y[j];
+        double dz = probe.z - charges.z[j];
+        double r2 = dx * dx + dy * dy + dz * dz;
+        if (r2 >= cutoff2 || r2 == 0.0) {
+            continue;
+        }
+        double s, energy;
+        pairTerms(K * charges.q[j], r2, s, energy);
+        field.Ex += s * dx;
+        field.Ey += s * dy;
+        field.Ez += s * dz;
+    }
+    return field;
+}
+
+// Forces on charges in cells [startCell, endCell). Every thread owns whole cells and computes the full force
+// on its own charges, so no two threads ever write the same entry; each pair energy is counted half per side.
+void ECE_CellList::interactCells(int startCell, int endCell, CoulombResult& result, double& energy) const {
+    CompensatedSum energySum;
+
+    for (int cell = startCell; cell < endCell; ++cell) {
+        int cx = cell % nx;
+        int cy = (cell / nx) % ny;
+        int cz = cell / (nx * ny);
+
+        for (int k = cellStart[cell]; k < cellStart[cell + 1]; ++k) {
+            int i = sortedIndex[k];
+            double xi = charges.x[i], yi = charges.y[i], zi = charges.z[i], kqi = K * charges.q[i];
+            double fx = 0.0, fy = 0.0, fz = 0.0, ei = 0.0;
+
+            for (int z = std::max(0, cz - 1); z <= std::min(nz - 1, cz + 1); ++z) {
+                for (int y = std::max(0, cy - 1); y <= std::min(ny - 1, cy + 1); ++y) {
+                    for (int x = std::max(0, cx - 1); x <= std::min(nx - 1, cx + 1); ++x) {
+                        int neighbour = (z * ny + y) * nx + x;
+                        for (int m = cellStart[neighbour]; m < cellStart[neighbour + 1]; ++m) {
+                            int j = sortedIndex[m];
+                            double dx = xi - charges.x[j];
+                            double dy = yi - charges.y[j];
+                            double dz = zi - charges.z[j];
+                            double r2 = dx * dx + dy * dy + dz * dz;
+                            if (j == i || r2 >= cutoff2) {
+                                continue;
+                            }
+                            double s, pairEnergy;
+                            pairTerms(kqi * charges.q[j], r2, s, pairEnergy);
+                            fx += s * dx;
+                            fy += s * dy;
+                            fz += s * dz;
+                            ei += pairEnergy;
+                        }
+                    }
+                }
+            }
+
+            result.Fx[i] = fx;
+            result.Fy[i] = fy;
+            result.Fz[i] = fz;
+            energySum.add(0.5 * ei);
+        }
+    }
+
+    energy = energySum.value();
+}
+
+// Forces and potential energy of all pairs within the cutoff, split across numThreads threads.
+CoulombResult ECE_CellList::computeInteractions(int numThreads) const {
+    size_t n = charges.size();
+    CoulombResult result;
+    result.Fx.assign(n, 0.0);
+    result.Fy.assign(n, 0.0);
+    result.Fz.assign(n, 0.0);
+    result.potentialEnergy = 0.0;
+
+    auto ranges = calculateDataDistribution(nx * ny * nz, std::max(1, numThreads));
+    std::vector<double> threadEnergy(ranges.size(), 0.0);
+    std::vector<std::thread> threads(ranges.size());
+    for (size_t t = 0; t < ranges.size(); ++t) {
+        threads[t] = std::thread(&ECE_CellList::interactCells, this, ranges[t].start, ranges[t].end,
+                                 std::ref(result), std::ref(threadEnergy[t]));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    CompensatedSum energySum;
+    for (double energy : threadEnergy) {
+        energySum.add(energy);
+    }
+    result.potentialEnergy = energySum.value();
+
+    return result;
+}
+
+// Number of cells along each axis.
+void ECE_CellList::getCellCounts(int &nx, int &ny, int &nz) const {
+    nx = this->nx;
+    ny = this->ny;
+    nz = this->nz;
+}
@@ -0,0 +1,66 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Contains the cutoff-radius cell-list evaluator. Charges are bucketed into a uniform grid of cells
+no smaller than the cutoff, so each probe or charge only visits its own and the neighbouring cells.
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "ECE_ElectricFieldUtils.h"
+#include "ECE_CoulombInteractions.h"
+
+// Field at one probe point
+struct FieldSample {
+    double Ex;
+    double Ey;
+    double Ez;
+};
+
+class ECE_CellList {
+public:
+    // Bucket the charges into cells of at least the cutoff radius (m). The list keeps its own copy of the charges.
+    // With shiftedForce the pair force and energy are shifted so both go smoothly to zero at the cutoff.
+    ECE_CellList(const ChargeArrays& charges, double cutoff, bool shiftedForce);
+
+    // Field at every probe point from the charges within the cutoff, split across numThreads threads.
+    std::vector<FieldSample> computeFieldAt(const std::vector<Point3D>& probes, int numThreads) const;
+
+    // Field at one probe point from a scan of every charge with the same cutoff, as a reference for computeFieldAt.
+    FieldSample computeFieldDirect(const Point3D& probe) const;
+
+    // Forces and potential energy of all pairs within the cutoff, split across numThreads threads.
+    CoulombResult computeInteractions(int numThreads) const;
+
+    // Number of cells along each axis.
+    void getCellCounts(int &nx, int &ny, int &nz) const;
+
+private:
+    // Cell index of a position, clamped to the grid.
+    int cellOf(double x, double y, double z) const;
+
+    // Cell coordinates of a position, clamped to the grid.
+    void cellCoordinates(double x, double y, double z, int &cx, int &cy, int &cz) const;
+
+    // Field at one probe point.
+    FieldSample fieldAt(const Point3D& probe) const;
+
+    // Forces on charges in cells [startCell, endCell) from every neighbour within the cutoff.
+    void interactCells(int startCell, int endCell, CoulombResult& result, double& energy) const;
+
+    // Scalar factor s(r) with F = s * d and the pair energy for a pair at squared distance r2.
+    void pairTerms(double kqq, double r2, double &s, double &energy) const;
+
+    const ChargeArrays charges;
+    double cutoff;
+    double cutoff2;
+    bool shiftedForce;
+    double minX, minY, minZ;
+    double cellSize;
+    int nx, ny, nz;
+    std::vector<int> cellStart;     // Offsets of each cell in sortedIndex (size numCells + 1)
+    std::vector<int> sortedIndex;   // Charge indices ordered by cell
+};
@@ -0,0 +1,37 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Contains functions related to a moving point charge such as setting up its mass and velocity.
+*/
+
+#include "ECE_ChargedParticle.h"
+
+// Constructor to initialize position (x, y, z), charge (q), mass and a particle at rest.
+ECE_ChargedParticle::ECE_ChargedParticle(double x, double y, double z, double q, double mass)
+    : ECE_PointCharge(x, y, z, q), mass(mass), vx(0.0), vy(0.0), vz(0.0) {
+}
+
+// Set the mass of the particle.
+void ECE_ChargedParticle::setMass(double mass) {
+    this->mass = mass;
+}
+
+// Set the velocity (vx, vy, vz) of the particle.
+void ECE_ChargedParticle::setVelocity(double vx, double vy, double vz) {
+    this->vx = vx;
+    this->vy = vy;
+    this->vz = vz;
+}
+
+// Getter function to retrieve the mass of the particle.
+double ECE_ChargedParticle::getMass() const {
+    return mass;
+}
+
+// Get the velocity components.
+void ECE_ChargedParticle::getVelocity(double &vx, double &vy, double &vz) const {
+    vx = this->vx;
+    vy = this->vy;
+    vz = this->vz;
+}
@@ -0,0 +1,34 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Contains functions related to a moving point charge such as setting up its mass and velocity.
+*/
+
+#pragma once
+
+#include "ECE_PointCharge.h"
+
+class ECE_ChargedParticle : public ECE_PointCharge {
+protected:
+    double mass; // mass of the particle in kg.
+    double vx;   // x-component of the velocity.
+    double vy;   // y-component of the velocity.
+    double vz;   // z-component of the velocity.
+
+public:
+    // Constructor to initialize position (x, y, z), charge (q), mass and a particle at rest.
+    ECE_ChargedParticle(double x, double y, double z, double q, double mass);
+
+    // Set the mass of the particle.
+    void setMass(double mass);
+
+    // Set the velocity (vx, vy, vz) of the particle.
+    void setVelocity(double vx, double vy, double vz);
+
+    // Getter function to retrieve the mass of the particle.
+    double getMass() const;
+
+    // Get the velocity components.
+    void getVelocity(double &vx, double &vy, double &vz) const;
+};
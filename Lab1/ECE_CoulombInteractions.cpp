@@ -0,0 +1,206 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Contains the all-pairs Coulomb interaction engine. The charge set is cut into tiles, every tile pair
+(I, J) with J >= I is assigned to one thread, and each pair of charges is evaluated once with the reaction
+force applied to the partner. Threads write into private force buffers that are reduced in parallel afterwards.
+*/
+
+#include "ECE_CoulombInteractions.h"
+#include "ECE_ElectricFieldUtils.h"
+#include <thread>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+constexpr double K = 9e9;              // Coulomb's Constant
+constexpr size_t TILE_SIZE = 256;      // Charges per tile; 4 arrays of a tile pair stay in L1/L2
+
+// Kahan-Neumaier compensated addition
+void CompensatedSum::add(double value) {
+    double t = sum + value;
+    if (std::fabs(sum) >= std::fabs(value)) {
+        compensation += (sum - t) + value;
+    } else {
+        compensation += (value - t) + sum;
+    }
+    sum = t;
+}
+
+double CompensatedSum::value() const {
+    return sum + compensation;
+}
+
+// Pair up tile I with tile J. The inner loop over j is a straight SoA loop the compiler can vectorise;
+// the force on i is a lane reduction and the reaction on j is a contiguous store.
+static double interactTiles(const ChargeArrays& charges, size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
+                            double cutoff2, double* __restrict fx, double* __restrict fy, double* __restrict fz) {
+    const double* __restrict x = charges.x.data();
+    const double* __restrict y = charges.y.data();
+    const double* __restrict z = charges.z.data();
+    const double* __restrict q = charges.q.data();
+    bool diagonal = (iBegin == jBegin);
+    double tileEnergy = 0.0;
+
+    for (size_t i = iBegin; i < iEnd; ++i) {
+        double xi = x[i], yi = y[i], zi = z[i], kqi = K * q[i];
+        double fxi = 0.0, fyi = 0.0, fzi = 0.0, ei = 0.0;
+        size_t jStart = diagonal ? i + 1 : jBegin;
+
+        #pragma omp simd reduction(+:fxi, fyi, fzi, ei)
+        for (size_t j = jStart; j < jEnd; ++j) {
+            double dx = x[j] - xi;
+            double dy = y[j] - yi;
+            double dz = z[j] - zi;
+            double r2 = dx * dx + dy * dy + dz * dz;
+            double invR = 1.0 / std::sqrt(r2);
+            // Branch-free cutoff mask keeps the loop vectorised
+            double inRange = (r2 < cutoff2) ? 1.0 : 0.0;
+            double pairEnergy = inRange * kqi * q[j] * invR;
+            double s = pairEnergy * invR * invR;
+
+            // Force on j points away from i for like charges; i receives the opposite
+            fx[j] += s * dx;
+            fy[j] += s * dy;
+            fz[j] += s * dz;
+            fxi -= s * dx;
+            fyi -= s * dy;
+            fzi -= s * dz;
+            ei += pairEnergy;
+        }
+
+        fx[i] += fxi;
+        fy[i] += fyi;
+        fz[i] += fzi;
+        tileEnergy += ei;
+    }
+
+    return tileEnergy;
+}
+
+// Axis-aligned bounding box of one tile
+struct TileBounds {
+    double minX, minY, minZ;
+    double maxX, maxY, maxZ;
+};
+
+// Squared gap between two boxes along one axis (zero when they overlap)
+static double axisGap2(double minA, double maxA, double minB, double maxB) {
+    double gap = std::max(0.0, std::max(minA - maxB, minB - maxA));
+    return gap * gap;
+}
+
+// Process tile pairs [startPair, endPair) into a private force buffer
+static void interactTilePairs(const ChargeArrays& charges, const std::vector<std::pair<size_t, size_t>>& tilePairs,
+                              const std::vector<TileBounds>& bounds, double cutoff2,
+                              int startPair, int endPair, std::vector<double>& buffer, double& energy) {
+    size_t n = charges.size();
+    double* fx = buffer.data();
+    double* fy = fx + n;
+    double* fz = fy + n;
+    CompensatedSum energySum;
+
+    for (int p = startPair; p < endPair; ++p) {
+        const TileBounds& a = bounds[tilePairs[p].first];
+        const TileBounds& b = bounds[tilePairs[p].second];
+        double gap2 = axisGap2(a.minX, a.maxX, b.minX, b.maxX) + axisGap2(a.minY, a.maxY, b.minY, b.maxY) + axisGap2(a.minZ, a.maxZ, b.minZ, b.maxZ);
+        if (gap2 >= cutoff2) {
+            continue;  // No pair of charges in these tiles is within the cutoff
+        }
+
+        size_t iBegin = tilePairs[p].first * TILE_SIZE;
+        size_t jBegin = tilePairs[p].second * TILE_SIZE;
+        size_t iEnd = std::min(iBegin + TILE_SIZE, n);
+        size_t jEnd = std::min(jBegin + TILE_SIZE, n);
+        energySum.add(interactTiles(charges, iBegin, iEnd, jBegin, jEnd, cutoff2, fx, fy, fz));
+    }
+
+    energy = energySum.value();
+}
+
+// Sum the private buffers of every thread for charges [start, end)
+static void reduceForces(const std::vector<std::vector<double>>& buffers, size_t n, int start, int end, CoulombResult& result) {
+    for (int i = start; i < end; ++i) {
+        double fx = 0.0, fy = 0.0, fz = 0.0;
+        for (const auto& buffer : buffers) {
+            fx += buffer[i];
+            fy += buffer[n + i];
+            fz += buffer[2 * n + i];
+        }
+        result.Fx[i] = fx;
+        result.Fy[i] = fy;
+        result.Fz[i] = fz;
+    }
+}
+
+// Compute all pairwise forces and the potential energy with numThreads worker threads.
+CoulombResult computeCoulombInteractions(const ChargeArrays& charges, int numThreads, double cutoff) {
+    size_t n = charges.size();
+    CoulombResult result;
+    result.Fx.assign(n, 0.0);
+    result.Fy.assign(n, 0.0);
+    result.Fz.assign(n, 0.0);
+    result.potentialEnergy = 0.0;
+    if (n < 2) {
+        return result;
+    }
+
+    // Upper-triangular list of tile pairs; consecutive pairs share tile I so a thread's i-data stays cached
+    size_t numTiles = (n + TILE_SIZE - 1) / TILE_SIZE;
+    std::vector<std::pair<size_t, size_t>> tilePairs;
+    tilePairs.reserve(numTiles * (numTiles + 1) / 2);
+    for (size_t I = 0; I < numTiles; ++I) {
+        for (size_t J = I; J < numTiles; ++J) {
+            tilePairs.emplace_back(I, J);
+        }
+    }
+
+    // Tile bounding boxes for cutoff culling
+    double cutoff2 = (cutoff > 0.0) ? cutoff * cutoff : std::numeric_limits<double>::infinity();
+    std::vector<TileBounds> bounds(numTiles);
+    for (size_t T = 0; T < numTiles; ++T) {
+        TileBounds& box = bounds[T];
+        box.minX = box.minY = box.minZ = std::numeric_limits<double>::infinity();
+        box.maxX = box.maxY = box.maxZ = -std::numeric_limits<double>::infinity();
+        for (size_t i = T * TILE_SIZE; i < std::min((T + 1) * TILE_SIZE, n); ++i) {
+            box.minX = std::min(box.minX, charges.x[i]);
+            box.minY = std::min(box.minY, charges.y[i]);
+            box.minZ = std::min(box.minZ, charges.z[i]);
+            box.maxX = std::max(box.maxX, charges.x[i]);
+            box.maxY = std::max(box.maxY, charges.y[i]);
+            box.maxZ = std::max(box.maxZ, charges.z[i]);
+        }
+    }
+
+    auto pairRanges = calculateDataDistribution(static_cast<int>(tilePairs.size()), std::max(1, numThreads));
+    std::vector<std::vector<double>> buffers(pairRanges.size(), std::vector<double>(3 * n, 0.0));
+    std::vector<double> threadEnergy(pairRanges.size(), 0.0);
+    std::vector<std::thread> threads(pairRanges.size());
+
+    for (size_t t = 0; t < pairRanges.size(); ++t) {
+        threads[t] = std::thread(interactTilePairs, std::cref(charges), std::cref(tilePairs), std::cref(bounds), cutoff2, pairRanges[t].start,
+                                 pairRanges[t].end, std::ref(buffers[t]), std::ref(threadEnergy[t]));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Reduce the private buffers, splitting the charges across the same number of threads
+    auto chargeRanges = calculateDataDistribution(static_cast<int>(n), std::max(1, numThreads));
+    threads.resize(chargeRanges.size());
+    for (size_t t = 0; t < chargeRanges.size(); ++t) {
+        threads[t] = std::thread(reduceForces, std::cref(buffers), n, chargeRanges[t].start, chargeRanges[t].end, std::ref(result));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    CompensatedSum energySum;
+    for (double energy : threadEnergy) {
+        energySum.add(energy);
+    }
+    result.potentialEnergy = energySum.value();
+
+    return result;
+}
@@ -0,0 +1,63 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Contains the all-pairs Coulomb interaction engine. Computes the net force on every charge of a
+configuration and its total electrostatic potential energy using tiled, vectorisable kernels.
+*/
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include "ECE_PointCharge.h"
+
+// Structure-of-arrays copy of a charge set used by the interaction kernels (positions in m, charges in C)
+struct ChargeArrays {
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+    std::vector<double> q;
+
+    size_t size() const { return q.size(); }
+};
+
+// Net force on every charge (N) and the total potential energy (J) of the configuration
+struct CoulombResult {
+    std::vector<double> Fx;
+    std::vector<double> Fy;
+    std::vector<double> Fz;
+    double potentialEnergy;
+};
+
+// Kahan-Neumaier compensated accumulator for long sums of mixed-magnitude terms
+struct CompensatedSum {
+    double sum = 0.0;
+    double compensation = 0.0;
+
+    void add(double value);
+    double value() const;
+};
+
+// Copy any container of ECE_PointCharge (or derived) objects into SoA form, converting micro C to C.
+template <typename Container>
+ChargeArrays packCharges(const Container& charges) {
+    ChargeArrays packed;
+    packed.x.reserve(charges.size());
+    packed.y.reserve(charges.size());
+    packed.z.reserve(charges.size());
+    packed.q.reserve(charges.size());
+    for (const ECE_PointCharge& charge : charges) {
+        packed.x.push_back(charge.getX());
+        packed.y.push_back(charge.getY());
+        packed.z.push_back(charge.getZ());
+        packed.q.push_back(charge.getQ() * 1e-6);
+    }
+    return packed;
+}
+
+// Compute all pairwise forces and the potential energy with numThreads worker threads.
+// Each unordered pair is evaluated once (Newton's third law); threads accumulate into private force buffers.
+// A positive cutoff (m) drops pairs further apart than the cutoff and skips tile pairs whose bounding boxes are out of range.
+CoulombResult computeCoulombInteractions(const ChargeArrays& charges, int numThreads, double cutoff = 0.0);
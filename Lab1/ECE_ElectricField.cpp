@@ -33,3 +33,16 @@ void ECE_ElectricField::getElectricField(double &Ex, double &Ey, double &Ez) {
     Ey = this->Ey;
     Ez = this->Ez;
 }
+
+// Add the field of this charge at a specified point to the running totals
+void ECE_ElectricField::addFieldAt(double x, double y, double z, double &Ex, double &Ey, double &Ez) const {
+    double dx = x - this->x;
+    double dy = y - this->y;
+    double dz = z - this->z;
+    double r2 = dx * dx + dy * dy + dz * dz;
+    double scale = K * q * 1e-6 / (r2 * sqrt(r2));
+
+    Ex += scale * dx;
+    Ey += scale * dy;
+    Ez += scale * dz;
+}
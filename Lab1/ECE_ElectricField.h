@@ -24,4 +24,7 @@ public:
 
     // Get the electric field components.
     void getElectricField(double &Ex, double &Ey, double &Ez);
+
+    // Add the field of this charge at a specified point to (Ex, Ey, Ez) without storing it.
+    void addFieldAt(double x, double y, double z, double &Ex, double &Ey, double &Ez) const;
 };
@@ -18,24 +18,8 @@ grid creation, Checking for overlap , Calculating the thread work distribution e
 
 // Calculate grid coordinates based on parameters
 std::vector<Point3D> calculateGridCoordinates(int N, int M, double x_sep, double y_sep) {
-    // Calculate the upper left corner coordinates
-    double upper_left_x = -(N - 1) * x_sep / 2;
-    double upper_left_y = (M - 1) * y_sep / 2;
-
-    // Initialize a vector to store the coordinates of all points
     std::vector<Point3D> coordinates;
-
-    // Iterate rows
-    for (int i = 0; i < M; i++) {
-        double y = upper_left_y - i * y_sep;
-        // Iterate columns
-        for (int j = 0; j < N; j++) {
-            double x = upper_left_x + j * x_sep;
-            Point3D point = {x, y, 0.0}; // Initialize z-coordinate to 0
-            coordinates.push_back(point);
-        }
-    }
-
+    fillGridCoordinates(N, M, x_sep, y_sep, coordinates);
     return coordinates;
 }
 
@@ -50,17 +34,6 @@ void printGrid(const std::vector<Point3D>& coordinates, int N, int M) {
     }
 }
 
-// Check if a user-defined point overlaps with any grid points
-bool validateOverlap(const Point3D& userPoint, const std::vector<Point3D>& gridPoints) {
-    for (const auto& gridPoint : gridPoints) {
-        if (userPoint.x == gridPoint.x && userPoint.y == gridPoint.y && userPoint.z == gridPoint.z) {
-            std::cout << gridPoint.x << " " << gridPoint.y << " " << gridPoint.z << std::endl;
-            return true; // Found an overlap
-        }
-    }
-    return false; // No overlap found
-}
-
 // Print a value in scientific notation
 void printScientificNotation(const std::string& label, double value, int precision) {
     if (value == 0.0) {
@@ -75,26 +48,7 @@ void printScientificNotation(const std::string& label, double value, int precisi
 
 // Calculate data distribution for parallel processing
 std::vector<ThreadRange> calculateDataDistribution(int totalDataPoints, int maxConcurrency) {
-    int numThreads = std::min(maxConcurrency, totalDataPoints);
-
-    // Calculate the number of data points per thread and the remaining data points
-    int dataPointsPerThread = totalDataPoints / numThreads;
-    int remainingDataPoints = totalDataPoints % numThreads;
-
-    // Create a vector to store the start and end indices for each thread
-    std::vector<ThreadRange> threadRanges(numThreads);
-
-    int currentIndex = 0;
-
-    for (int i = 0; i < numThreads; ++i) {
-        threadRanges[i].start = currentIndex;
-
-        // Distribute the remaining data points from the top
-        int extraDataPoints = (i < remainingDataPoints) ? 1 : 0;
-        currentIndex += dataPointsPerThread + extraDataPoints;
-
-        threadRanges[i].end = currentIndex;
-    }
-
+    std::vector<ThreadRange> threadRanges;
+    fillDataDistribution(totalDataPoints, maxConcurrency, threadRanges);
     return threadRanges;
 }
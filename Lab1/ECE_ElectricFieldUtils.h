@@ -14,6 +14,9 @@ Description: Contains utility functions related to E.Field Calculation such as g
 #include <cmath>
 #include <iomanip>
 #include <mutex>
+#include <algorithm>
+#include <cstdlib>
+#include <cctype>
 
 
 // Structure to represent a 3D point
@@ -38,36 +41,52 @@ struct ThreadResult {
 
 
 
-// Function to split a string into a vector of values
+// Function to split a string into a vector of values. Tokens are converted in place with strtod, so apart from
+// growing results nothing is allocated.
 template<typename T>
 bool splitInputs(const std::string& s, char delimiter, std::vector<T>& results) {
-    bool conversionSuccessful = true;
-
     if (s.empty()) {
         return false;  // Input string is empty
     }
 
-    std::string token;
-    std::istringstream tokenStream(s);
-    while (std::getline(tokenStream, token, delimiter)) {
-        for (char c : token) {
-            if (!std::isdigit(c) && c != '-' && c != '.') {
-                conversionSuccessful = false;
+    const char* text = s.c_str();
+    size_t position = 0;
+    while (position < s.size()) {
+        size_t tokenEnd = s.find(delimiter, position);
+        if (tokenEnd == std::string::npos) {
+            tokenEnd = s.size();
+        }
+        if (tokenEnd == position) {
+            ++position;  // Repeated delimiter
+            continue;
+        }
+
+        for (size_t i = position; i < tokenEnd; ++i) {
+            char c = text[i];
+            if (!std::isdigit(static_cast<unsigned char>(c)) && c != '-' && c != '+' && c != '.' && c != 'e' && c != 'E') {  // Allow scientific notation
                 std::cerr << "[ERROR] Enter a valid numeric type!" << std::endl;
                 return false;
             }
         }
 
-        try {
-            results.push_back(static_cast<T>(std::stod(token)));
-        } catch (const std::exception& e) {
-            // Handle the exception (e.g., by throwing or logging an error)
-            conversionSuccessful = false;
-            std::cerr << "[ERROR] Invalid conversion: " << token << std::endl;
+        char* parsedEnd = nullptr;
+        double value = std::strtod(text + position, &parsedEnd);
+        if (parsedEnd != text + tokenEnd) {
+            std::cerr << "[ERROR] Invalid conversion: ";
+            std::cerr.write(text + position, tokenEnd - position) << std::endl;
+            return false;
         }
+        results.push_back(static_cast<T>(value));
+        position = tokenEnd + 1;
     }
 
-    return conversionSuccessful;
+    return true;
+}
+
+// Line buffer shared by the getInput calls of a thread, so its capacity is reused from one query to the next
+inline std::string& inputLineBuffer() {
+    thread_local std::string inputLine;
+    return inputLine;
 }
 
 
@@ -83,85 +102,151 @@ bool validateBounds(const std::vector<T>& values)
     return true;
 }
 
+// Function to validate that values are zero or greater
+template<typename T>
+bool validateNonNegative(const std::vector<T>& values)
+{
+    for (auto val : values)
+    {
+        if (val < 0)
+            return false;
+    }
+    return true;
+}
+
 // Function to get user input with validation
 template <typename T>
-void getInput(const std::string& prompt, std::vector<T>& values, int expectedNumber, const std::string& error, bool (*validationFunction)(const std::vector<T>&))
+void getInput(const char* prompt, std::vector<T>& values, int expectedNumber, const char* error, bool (*validationFunction)(const std::vector<T>&))
 {
     bool endLoop = false;
     do
     {
         std::cout << prompt;
-        std::string inputLine;
+        std::string& inputLine = inputLineBuffer();
         std::getline(std::cin, inputLine);
-        std::vector<T> results;
-        if (!splitInputs(inputLine, ' ', results))
+        // Parse straight into the caller's vector so its capacity is reused across queries
+        values.clear();
+        if (!splitInputs(inputLine, ' ', values))
         {
             continue;
         }
 
-        if (results.size() != expectedNumber)
+        if (values.size() != expectedNumber)
         {
             std::cout << "[ERROR] Invalid Number of Arguments Entered! " << std::endl;
             continue;
         }
 
-        if (!validationFunction(results))
+        if (!validationFunction(values))
         {
             std::cout << "[ERROR] " << error << std::endl;
             continue;
         }
 
-        values = results;
-
         endLoop = true;
 
     } while (!endLoop);
 }
 
 // Function to get user input with point validation
-template <typename T>
-void getInput(const std::string& prompt, std::vector<T>& values, int expectedNumber, const std::string& error,  bool (*validationFunction)(const Point3D&, const std::vector<Point3D>&), const std::vector<Point3D>& gridPoints)
+template <typename T, typename GridContainer>
+void getInput(const char* prompt, std::vector<T>& values, int expectedNumber, const char* error,  bool (*validationFunction)(const Point3D&, const GridContainer&), const GridContainer& gridPoints)
 {
     bool endLoop = false;
     do
     {
         std::cout << prompt;
-        std::string inputLine;
+        std::string& inputLine = inputLineBuffer();
         std::getline(std::cin, inputLine);
-        std::vector<T> results;
-        if (!splitInputs(inputLine, ' ', results))
+        values.clear();
+        if (!splitInputs(inputLine, ' ', values))
         {
             continue;
         }
 
-        if (results.size() != expectedNumber)
+        if (values.size() != expectedNumber)
         {
             std::cout << "[ERROR] Invalid Number of Arguments Entered! " << std::endl;
             continue;
         }
 
-        Point3D pointsToValidate = { results[0], results[1], results[2] };
+        Point3D pointsToValidate = { values[0], values[1], values[2] };
         if (validationFunction(pointsToValidate, gridPoints))
         {
             std::cout << "[ERROR] " << error << std::endl;
             continue;
         }
 
-        values = results;
-
         endLoop = true;
 
     } while (!endLoop);
 }
 
+// Check if a user-defined point overlaps with any grid points
+template <typename GridContainer>
+bool validateOverlap(const Point3D& userPoint, const GridContainer& gridPoints) {
+    for (const auto& gridPoint : gridPoints) {
+        if (userPoint.x == gridPoint.x && userPoint.y == gridPoint.y && userPoint.z == gridPoint.z) {
+            std::cout << gridPoint.x << " " << gridPoint.y << " " << gridPoint.z << std::endl;
+            return true; // Found an overlap
+        }
+    }
+    return false; // No overlap found
+}
+
+// Fill a caller-provided container with the grid coordinates (lets drivers supply arena-backed storage)
+template <typename Container>
+void fillGridCoordinates(int N, int M, double x_sep, double y_sep, Container& coordinates)
+{
+    // Calculate the upper left corner coordinates
+    double upper_left_x = -(N - 1) * x_sep / 2;
+    double upper_left_y = (M - 1) * y_sep / 2;
+
+    coordinates.clear();
+    coordinates.reserve(static_cast<size_t>(N) * M);
+
+    // Iterate rows
+    for (int i = 0; i < M; i++) {
+        double y = upper_left_y - i * y_sep;
+        // Iterate columns
+        for (int j = 0; j < N; j++) {
+            double x = upper_left_x + j * x_sep;
+            coordinates.push_back(Point3D{x, y, 0.0}); // Initialize z-coordinate to 0
+        }
+    }
+}
+
+// Fill a caller-provided container with the per-thread data ranges
+template <typename Container>
+void fillDataDistribution(int totalDataPoints, int maxConcurrency, Container& threadRanges)
+{
+    int numThreads = std::min(maxConcurrency, totalDataPoints);
+
+    // Calculate the number of data points per thread and the remaining data points
+    int dataPointsPerThread = totalDataPoints / numThreads;
+    int remainingDataPoints = totalDataPoints % numThreads;
+
+    threadRanges.resize(numThreads);
+
+    int currentIndex = 0;
+
+    for (int i = 0; i < numThreads; ++i) {
+        threadRanges[i].start = currentIndex;
+
+        // Distribute the remaining data points from the top
+        int extraDataPoints = (i < remainingDataPoints) ? 1 : 0;
+        currentIndex += dataPointsPerThread + extraDataPoints;
+
+        threadRanges[i].end = currentIndex;
+    }
+}
+
 // Calculate grid coordinates based on parameters
 std::vector<Point3D> calculateGridCoordinates(int N, int M, double x_sep, double y_sep);
 
 // Print the grid coordinates
 void printGrid(const std::vector<Point3D>& coordinates, int N, int M);
 
-// Check if a user-defined point overlaps with any grid points
-bool validateOverlap(const Point3D& userPoint, const std::vector<Point3D>& gridPoints);
 
 // Print a value in scientific notation
 void printScientificNotation(const std::string& label, double value, int precision);
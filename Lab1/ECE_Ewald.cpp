@@ -0,0 +1,441 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Contains the Ewald and smooth particle-mesh Ewald (PME) solvers. The Coulomb sum is split into a
+short-ranged erfc part summed in real space over every periodic image within the cutoff (found through
+periodic bins, so the cutoff may exceed the cell) and a smooth part summed in reciprocal space, either over explicit k-vectors (Ewald) or through cubic B-spline charge spreading and the in-project
+FFT (PME, Essmann et al. 1995).
+*/
+
+#include "ECE_Ewald.h"
+#include "ECE_FFT.h"
+#include <thread>
+#include <cmath>
+#include <algorithm>
+
+constexpr double K = 9e9;  // Coulomb's Constant
+
+// Unit cell of the lattice from calculateGridCoordinates(N, M, x_sep, y_sep), repeated every Lz along z.
+// The grid is centred on the origin, so the cell is centred there too.
+PeriodicCell makeLatticeCell(int N, int M, double x_sep, double y_sep, double Lz) {
+    PeriodicCell cell;
+    cell.Lx = N * x_sep;
+    cell.Ly = M * y_sep;
+    cell.Lz = Lz;
+    cell.originX = -cell.Lx / 2;
+    cell.originY = -cell.Ly / 2;
+    cell.originZ = -cell.Lz / 2;
+    return cell;
+}
+
+// Splitting parameter from the classic cost balance alpha = sqrt(pi) (N / V^2)^(1/6), which depends on the
+// cell volume rather than its shortest edge, so flat cells do not force a huge alpha.
+EwaldParameters chooseEwaldParameters(const PeriodicCell& cell, size_t numCharges, double tolerance) {
+    EwaldParameters params;
+    double volume = cell.Lx * cell.Ly * cell.Lz;
+
+    // erfc(alpha rc) and exp(-kc^2 / 4 alpha^2) both fall to about the tolerance
+    double s = std::sqrt(-std::log(tolerance));
+    params.alpha = std::sqrt(M_PI) * std::pow(std::max<size_t>(1, numCharges) / (volume * volume), 1.0 / 6.0);
+    params.realCutoff = s / params.alpha;
+    double kCutoff = 2.0 * params.alpha * s;
+    const double lengths[3] = {cell.Lx, cell.Ly, cell.Lz};
+    for (int axis = 0; axis < 3; ++axis) {
+        params.kmax[axis] = static_cast<int>(std::ceil(kCutoff * lengths[axis] / (2.0 * M_PI)));
+    }
+
+    // Mesh density (points per 1/alpha) whose spline error meets the tolerance, halved while the mesh is too large
+    double density = MIN_MESH_DENSITY * std::max(1.0, std::cbrt(MESH_ERROR_AT_MIN_DENSITY / tolerance));
+    while (true) {
+        for (int axis = 0; axis < 3; ++axis) {
+            double points = std::min(1e9, std::ceil(density * params.alpha * lengths[axis]));
+            params.mesh[axis] = static_cast<int>(nextPowerOfTwo(std::max<size_t>(8, static_cast<size_t>(points))));
+        }
+        if (meshPointCount(params) <= MAX_MESH_POINTS || density <= MIN_MESH_DENSITY) {
+            break;
+        }
+        density = std::max(MIN_MESH_DENSITY, density / 2.0);
+    }
+
+    // Power-of-two rounding only refines the mesh, so estimate the error from the coarsest axis as built
+    double achieved = 1e9;
+    for (int axis = 0; axis < 3; ++axis) {
+        achieved = std::min(achieved, params.mesh[axis] / (params.alpha * lengths[axis]));
+    }
+    double ratio = MIN_MESH_DENSITY / achieved;
+    params.meshTolerance = std::max(tolerance, MESH_ERROR_AT_MIN_DENSITY * ratio * ratio * ratio);
+    return params;
+}
+
+// Mesh points the parameters call for (saturating rather than overflowing).
+size_t meshPointCount(const EwaldParameters& params) {
+    double points = static_cast<double>(params.mesh[0]) * params.mesh[1] * params.mesh[2];
+    return points > 1e18 ? static_cast<size_t>(1e18) : static_cast<size_t>(points);
+}
+
+// Bounding box of the half-space k-vectors the parameters call for.
+size_t kVectorBound(const EwaldParameters& params) {
+    double count = (params.kmax[0] + 1.0) * (2.0 * params.kmax[1] + 1.0) * (2.0 * params.kmax[2] + 1.0);
+    return count > 1e18 ? static_cast<size_t>(1e18) : static_cast<size_t>(count);
+}
+
+// Run body(start, end) over [0, count) on numThreads threads
+template <typename Body>
+static void parallelRanges(int count, int numThreads, Body body) {
+    if (count <= 0) {
+        return;
+    }
+    auto ranges = calculateDataDistribution(count, std::max(1, numThreads));
+    std::vector<std::thread> threads(ranges.size());
+    for (size_t t = 0; t < ranges.size(); ++t) {
+        threads[t] = std::thread(body, static_cast<int>(t), ranges[t].start, ranges[t].end);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+// Pick parameters for the requested relative tolerance and precompute structure factors and the PME mesh.
+ECE_Ewald::ECE_Ewald(const ChargeArrays& charges, const PeriodicCell& cell, double tolerance, int numThreads)
+    : charges(charges), cell(cell), numThreads(numThreads), volume(cell.Lx * cell.Ly * cell.Lz),
+      totalCharge(0.0), sumSquaredCharge(0.0) {
+    for (double q : charges.q) {
+        totalCharge += q;
+        sumSquaredCharge += q * q;
+    }
+
+    params = chooseEwaldParameters(cell, charges.size(), tolerance);
+    double kCutoff = 2.0 * params.alpha * std::sqrt(-std::log(tolerance));
+    buildRealSpaceBins();
+
+    // Reciprocal vectors in one half-space; the other half is the complex conjugate
+    for (int a = 0; a <= params.kmax[0]; ++a) {
+        for (int b = -params.kmax[1]; b <= params.kmax[1]; ++b) {
+            for (int c = -params.kmax[2]; c <= params.kmax[2]; ++c) {
+                if (a == 0 && (b < 0 || (b == 0 && c <= 0))) {
+                    continue;
+                }
+                double vx = 2.0 * M_PI * a / cell.Lx;
+                double vy = 2.0 * M_PI * b / cell.Ly;
+                double vz = 2.0 * M_PI * c / cell.Lz;
+                double k2 = vx * vx + vy * vy + vz * vz;
+                if (k2 > kCutoff * kCutoff) {
+                    continue;
+                }
+                kx.push_back(vx);
+                ky.push_back(vy);
+                kz.push_back(vz);
+                kWeight.push_back(2.0 * (4.0 * M_PI * K / volume) * std::exp(-k2 / (4.0 * params.alpha * params.alpha)) / k2);
+            }
+        }
+    }
+
+    structure.assign(kx.size(), std::complex<double>(0.0, 0.0));
+    parallelRanges(static_cast<int>(kx.size()), numThreads, [this](int, int start, int end) {
+        for (int k = start; k < end; ++k) {
+            double re = 0.0, im = 0.0;
+            for (size_t j = 0; j < this->charges.size(); ++j) {
+                double phase = kx[k] * this->charges.x[j] + ky[k] * this->charges.y[j] + kz[k] * this->charges.z[j];
+                re += this->charges.q[j] * std::cos(phase);
+                im += this->charges.q[j] * std::sin(phase);
+            }
+            structure[k] = std::complex<double>(re, im);
+        }
+    });
+
+    buildMesh();
+}
+
+const EwaldParameters& ECE_Ewald::getParameters() const {
+    return params;
+}
+
+// Bucket the charges, wrapped into the cell, into bins no smaller than the real-space cutoff. When the cutoff is
+// longer than the cell along an axis there is a single bin and the search reaches across several images.
+void ECE_Ewald::buildRealSpaceBins() {
+    lengths[0] = cell.Lx;
+    lengths[1] = cell.Ly;
+    lengths[2] = cell.Lz;
+    origins[0] = cell.originX;
+    origins[1] = cell.originY;
+    origins[2] = cell.originZ;
+    for (int axis = 0; axis < 3; ++axis) {
+        double fit = std::floor(lengths[axis] / params.realCutoff);
+        bins[axis] = static_cast<int>(std::max(1.0, std::min(fit, 1024.0)));
+        reach[axis] = static_cast<int>(std::ceil(params.realCutoff * bins[axis] / lengths[axis]));
+    }
+
+    size_t n = charges.size();
+    int numBins = bins[0] * bins[1] * bins[2];
+    std::vector<int> binOfCharge(n);
+    wrappedX.resize(n);
+    wrappedY.resize(n);
+    wrappedZ.resize(n);
+    binStart.assign(numBins + 1, 0);
+    for (size_t j = 0; j < n; ++j) {
+        int bx = binAlong(charges.x[j], 0, wrappedX[j]);
+        int by = binAlong(charges.y[j], 1, wrappedY[j]);
+        int bz = binAlong(charges.z[j], 2, wrappedZ[j]);
+        binOfCharge[j] = (bz * bins[1] + by) * bins[0] + bx;
+        ++binStart[binOfCharge[j] + 1];
+    }
+    for (int b = 0; b < numBins; ++b) {
+        binStart[b + 1] += binStart[b];
+    }
+    std::vector<int> fill(binStart.begin(), binStart.end() - 1);
+    binIndex.resize(n);
+    for (size_t j = 0; j < n; ++j) {
+        binIndex[fill[binOfCharge[j]]++] = static_cast<int>(j);
+    }
+}
+
+// Bin and wrapped coordinate (relative to the cell origin, in [0, L)) of a position along one axis.
+int ECE_Ewald::binAlong(double position, int axis, double &wrapped) const {
+    double length = lengths[axis];
+    wrapped = position - origins[axis];
+    wrapped -= length * std::floor(wrapped / length);
+    int bin = static_cast<int>(wrapped * bins[axis] / length);
+    return std::min(bins[axis] - 1, std::max(0, bin));
+}
+
+// Every charge image within the real-space cutoff of a wrapped position: bins up to `reach` away on each axis,
+// where stepping past the edge of the cell moves to the neighbouring image. dx, dy, dz point from the image to
+// the position; the position's own charge at zero separation is included and left to the caller.
+template <typename Visit>
+void ECE_Ewald::forEachImageNear(const double wrapped[3], const int bin[3], Visit visit) const {
+    double cutoff2 = params.realCutoff * params.realCutoff;
+    for (int oz = -reach[2]; oz <= reach[2]; ++oz) {
+        int cz = bin[2] + oz;
+        int imageZ = static_cast<int>(std::floor(static_cast<double>(cz) / bins[2]));
+        int bz = cz - imageZ * bins[2];
+        double shiftZ = imageZ * lengths[2];
+        for (int oy = -reach[1]; oy <= reach[1]; ++oy) {
+            int cy = bin[1] + oy;
+            int imageY = static_cast<int>(std::floor(static_cast<double>(cy) / bins[1]));
+            int by = cy - imageY * bins[1];
+            double shiftY = imageY * lengths[1];
+            for (int ox = -reach[0]; ox <= reach[0]; ++ox) {
+                int cx = bin[0] + ox;
+                int imageX = static_cast<int>(std::floor(static_cast<double>(cx) / bins[0]));
+                int bx = cx - imageX * bins[0];
+                double shiftX = imageX * lengths[0];
+
+                int b = (bz * bins[1] + by) * bins[0] + bx;
+                for (int k = binStart[b]; k < binStart[b + 1]; ++k) {
+                    int j = binIndex[k];
+                    double dx = wrapped[0] - (wrappedX[j] + shiftX);
+                    double dy = wrapped[1] - (wrappedY[j] + shiftY);
+                    double dz = wrapped[2] - (wrappedZ[j] + shiftZ);
+                    double r2 = dx * dx + dy * dy + dz * dz;
+                    if (r2 < cutoff2) {
+                        visit(j, dx, dy, dz, r2);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Real-space part of the energy: half the erfc interaction of every charge with every image within the cutoff.
+double ECE_Ewald::realSpaceEnergy() const {
+    int n = static_cast<int>(charges.size());
+    std::vector<double> threadEnergy(std::max(1, numThreads), 0.0);
+
+    parallelRanges(n, numThreads, [&](int t, int start, int end) {
+        CompensatedSum energy;
+        for (int i = start; i < end; ++i) {
+            double wrapped[3] = {wrappedX[i], wrappedY[i], wrappedZ[i]};
+            int bin[3];
+            for (int axis = 0; axis < 3; ++axis) {
+                bin[axis] = std::min(bins[axis] - 1, static_cast<int>(wrapped[axis] * bins[axis] / lengths[axis]));
+            }
+            double ei = 0.0;
+            forEachImageNear(wrapped, bin, [&](int j, double, double, double, double r2) {
+                if (r2 > 0.0) {
+                    double r = std::sqrt(r2);
+                    ei += charges.q[j] * std::erfc(params.alpha * r) / r;
+                }
+            });
+            energy.add(0.5 * K * charges.q[i] * ei);
+        }
+        threadEnergy[t] = energy.value();
+    });
+
+    CompensatedSum total;
+    for (double energy : threadEnergy) {
+        total.add(energy);
+    }
+    return total.value();
+}
+
+// Real-space part of the field at a probe.
+FieldSample ECE_Ewald::realSpaceField(const Point3D& probe) const {
+    FieldSample field = {0.0, 0.0, 0.0};
+    double alpha = params.alpha;
+
+    double wrapped[3];
+    int bin[3] = {binAlong(probe.x, 0, wrapped[0]), binAlong(probe.y, 1, wrapped[1]), binAlong(probe.z, 2, wrapped[2])};
+    forEachImageNear(wrapped, bin, [&](int j, double dx, double dy, double dz, double r2) {
+        if (r2 == 0.0) {
+            return;
+        }
+        double r = std::sqrt(r2);
+        double s = K * charges.q[j] * (std::erfc(alpha * r) / r + 2.0 * alpha / std::sqrt(M_PI) * std::exp(-alpha * alpha * r2)) / r2;
+        field.Ex += s * dx;
+        field.Ey += s * dy;
+        field.Ez += s * dz;
+    });
+
+    return field;
+}
+
+// Reciprocal-space energy from the explicit k-vector sum.
+double ECE_Ewald::reciprocalEnergy() const {
+    CompensatedSum energy;
+    for (size_t k = 0; k < kx.size(); ++k) {
+        energy.add(0.5 * kWeight[k] * std::norm(structure[k]));
+    }
+    return energy.value();
+}
+
+// Reciprocal-space field from the explicit k-vector sum: E = sum_k w(k) k Im[S(k) exp(-i k.r)] with the sign folded in.
+FieldSample ECE_Ewald::reciprocalField(const Point3D& probe) const {
+    FieldSample field = {0.0, 0.0, 0.0};
+    for (size_t k = 0; k < kx.size(); ++k) {
+        double phase = kx[k] * probe.x + ky[k] * probe.y + kz[k] * probe.z;
+        double term = kWeight[k] * (std::sin(phase) * structure[k].real() - std::cos(phase) * structure[k].imag());
+        field.Ex += term * kx[k];
+        field.Ey += term * ky[k];
+        field.Ez += term * kz[k];
+    }
+    return field;
+}
+
+// Cubic B-spline weights (index firstIndex - j gets weights[j]) and their derivatives along one axis (per m).
+void ECE_Ewald::splineWeights(double position, double origin, double length, int meshSize, int &firstIndex,
+                              double weights[4], double derivatives[4]) const {
+    double u = meshSize * (position - origin) / length;
+    u -= meshSize * std::floor(u / meshSize);
+    double base = std::floor(u);
+    double t = u - base;
+    firstIndex = static_cast<int>(base);
+
+    weights[0] = t * t * t / 6.0;
+    weights[1] = (-3.0 * t * t * t + 3.0 * t * t + 3.0 * t + 1.0) / 6.0;
+    weights[2] = (3.0 * t * t * t - 6.0 * t * t + 4.0) / 6.0;
+    weights[3] = (1.0 - t) * (1.0 - t) * (1.0 - t) / 6.0;
+
+    double scale = meshSize / length;
+    derivatives[0] = scale * t * t / 2.0;
+    derivatives[1] = scale * (-3.0 * t * t + 2.0 * t + 1.0) / 2.0;
+    derivatives[2] = scale * (3.0 * t * t - 4.0 * t) / 2.0;
+    derivatives[3] = -scale * (1.0 - t) * (1.0 - t) / 2.0;
+}
+
+// Spread the charges on the mesh, convolve with the influence function and keep the potential mesh.
+void ECE_Ewald::buildMesh() {
+    const int n1 = params.mesh[0], n2 = params.mesh[1], n3 = params.mesh[2];
+    chargeMesh.assign(static_cast<size_t>(n1) * n2 * n3, 0.0);
+
+    for (size_t j = 0; j < charges.size(); ++j) {
+        int i1, i2, i3;
+        double w1[4], w2[4], w3[4], d[4];
+        splineWeights(charges.x[j], cell.originX, cell.Lx, n1, i1, w1, d);
+        splineWeights(charges.y[j], cell.originY, cell.Ly, n2, i2, w2, d);
+        splineWeights(charges.z[j], cell.originZ, cell.Lz, n3, i3, w3, d);
+        for (int a = 0; a < 4; ++a) {
+            int g1 = (i1 - a + n1) % n1;
+            for (int b = 0; b < 4; ++b) {
+                int g2 = (i2 - b + n2) % n2;
+                for (int c = 0; c < 4; ++c) {
+                    int g3 = (i3 - c + n3) % n3;
+                    chargeMesh[(static_cast<size_t>(g1) * n2 + g2) * n3 + g3] += charges.q[j] * w1[a] * w2[b] * w3[c];
+                }
+            }
+        }
+    }
+
+    std::vector<std::complex<double>> mesh(chargeMesh.begin(), chargeMesh.end());
+    fft3D(mesh, n1, n2, n3, false, numThreads);
+
+    // Influence function with the cubic Euler-spline correction |b(m)|^2 = 9 / (2 + cos(2 pi m / K))^2 per axis
+    const double alpha2 = params.alpha * params.alpha;
+    parallelRanges(n1, numThreads, [&](int, int start, int end) {
+        for (int m1 = start; m1 < end; ++m1) {
+            double k1 = 2.0 * M_PI * (m1 < n1 / 2 ? m1 : m1 - n1) / cell.Lx;
+            double b1 = 9.0 / std::pow(2.0 + std::cos(2.0 * M_PI * m1 / n1), 2);
+            for (int m2 = 0; m2 < n2; ++m2) {
+                double k2 = 2.0 * M_PI * (m2 < n2 / 2 ? m2 : m2 - n2) / cell.Ly;
+                double b2 = 9.0 / std::pow(2.0 + std::cos(2.0 * M_PI * m2 / n2), 2);
+                for (int m3 = 0; m3 < n3; ++m3) {
+                    double k3 = 2.0 * M_PI * (m3 < n3 / 2 ? m3 : m3 - n3) / cell.Lz;
+                    double b3 = 9.0 / std::pow(2.0 + std::cos(2.0 * M_PI * m3 / n3), 2);
+                    double ksq = k1 * k1 + k2 * k2 + k3 * k3;
+                    size_t index = (static_cast<size_t>(m1) * n2 + m2) * n3 + m3;
+                    if (ksq == 0.0) {
+                        mesh[index] = 0.0;  // The k = 0 term is cancelled by the neutralising background
+                    } else {
+                        mesh[index] *= (4.0 * M_PI * K / volume) * std::exp(-ksq / (4.0 * alpha2)) / ksq * b1 * b2 * b3;
+                    }
+                }
+            }
+        }
+    });
+
+    fft3D(mesh, n1, n2, n3, true, numThreads);
+    potentialMesh.resize(mesh.size());
+    for (size_t g = 0; g < mesh.size(); ++g) {
+        potentialMesh[g] = mesh[g].real();
+    }
+}
+
+// Reciprocal-space energy from the PME mesh: (1/2) sum_g Q(g) Phi(g).
+double ECE_Ewald::meshEnergy() const {
+    CompensatedSum energy;
+    for (size_t g = 0; g < chargeMesh.size(); ++g) {
+        energy.add(0.5 * chargeMesh[g] * potentialMesh[g]);
+    }
+    return energy.value();
+}
+
+// Reciprocal-space field from the PME mesh: E = -sum_g grad W(r, g) Phi(g).
+FieldSample ECE_Ewald::meshField(const Point3D& probe) const {
+    const int n1 = params.mesh[0], n2 = params.mesh[1], n3 = params.mesh[2];
+    int i1, i2, i3;
+    double w1[4], w2[4], w3[4], d1[4], d2[4], d3[4];
+    splineWeights(probe.x, cell.originX, cell.Lx, n1, i1, w1, d1);
+    splineWeights(probe.y, cell.originY, cell.Ly, n2, i2, w2, d2);
+    splineWeights(probe.z, cell.originZ, cell.Lz, n3, i3, w3, d3);
+
+    FieldSample field = {0.0, 0.0, 0.0};
+    for (int a = 0; a < 4; ++a) {
+        int g1 = (i1 - a + n1) % n1;
+        for (int b = 0; b < 4; ++b) {
+            int g2 = (i2 - b + n2) % n2;
+            for (int c = 0; c < 4; ++c) {
+                int g3 = (i3 - c + n3) % n3;
+                double phi = potentialMesh[(static_cast<size_t>(g1) * n2 + g2) * n3 + g3];
+                field.Ex -= d1[a] * w2[b] * w3[c] * phi;
+                field.Ey -= w1[a] * d2[b] * w3[c] * phi;
+                field.Ez -= w1[a] * w2[b] * d3[c] * phi;
+            }
+        }
+    }
+    return field;
+}
+
+// Electrostatic energy per unit cell: real + reciprocal + self + neutralising background.
+double ECE_Ewald::computeEnergy(bool useMesh) const {
+    double selfEnergy = -K * params.alpha / std::sqrt(M_PI) * sumSquaredCharge;
+    double backgroundEnergy = -K * M_PI * totalCharge * totalCharge / (2.0 * volume * params.alpha * params.alpha);
+    double reciprocal = useMesh ? meshEnergy() : reciprocalEnergy();
+    return realSpaceEnergy() + reciprocal + selfEnergy + backgroundEnergy;
+}
+
+// Field at a probe point from all periodic images of the charges.
+FieldSample ECE_Ewald::computeFieldAt(const Point3D& probe, bool useMesh) const {
+    FieldSample real = realSpaceField(probe);
+    FieldSample reciprocal = useMesh ? meshField(probe) : reciprocalField(probe);
+    return FieldSample{real.Ex + reciprocal.Ex, real.Ey + reciprocal.Ey, real.Ez + reciprocal.Ez};
+}
@@ -0,0 +1,124 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Contains the Ewald and smooth particle-mesh Ewald (PME) solvers for fields and energies of a
+charge set under periodic boundary conditions. The unit cell is derived from the N x M lattice description.
+*/
+
+#pragma once
+
+#include <vector>
+#include <complex>
+
+#include "ECE_ElectricFieldUtils.h"
+#include "ECE_CoulombInteractions.h"
+#include "ECE_CellList.h"
+
+// Orthorhombic periodic cell [origin, origin + L) along each axis
+struct PeriodicCell {
+    double Lx, Ly, Lz;
+    double originX, originY, originZ;
+};
+
+// Splitting and resolution parameters shared by the Ewald and PME solvers
+struct EwaldParameters {
+    double alpha;         // Ewald splitting parameter (1/m)
+    double realCutoff;    // Real-space cutoff (m)
+    int kmax[3];          // Largest reciprocal index per axis (Ewald)
+    int mesh[3];          // Mesh points per axis (PME, powers of two)
+    double meshTolerance; // Estimated relative error of the PME field, never below the requested tolerance
+};
+
+// Largest PME mesh and explicit k-vector box the solvers will build
+const size_t MAX_MESH_POINTS = size_t(1) << 24;
+const size_t MAX_K_VECTORS = size_t(1) << 22;
+
+// Cubic B-spline PME: the coarsest mesh (points per 1/alpha) and its measured relative field error, which
+// falls at least as fast as the cube of the mesh density
+const double MIN_MESH_DENSITY = 4.0;
+const double MESH_ERROR_AT_MIN_DENSITY = 1e-4;
+
+// Unit cell of the lattice from calculateGridCoordinates(N, M, x_sep, y_sep), repeated every Lz along z.
+PeriodicCell makeLatticeCell(int N, int M, double x_sep, double y_sep, double Lz);
+
+// Splitting parameter balancing real-space and reciprocal work for numCharges charges in the cell, the cutoffs
+// that meet the relative tolerance, and k-vector and mesh counts sized per axis from alpha times that axis' length.
+// The mesh is as fine as the tolerance needs unless that exceeds MAX_MESH_POINTS; meshTolerance reports the result.
+EwaldParameters chooseEwaldParameters(const PeriodicCell& cell, size_t numCharges, double tolerance);
+
+// Mesh points and the bounding box of explicit k-vectors the parameters call for.
+size_t meshPointCount(const EwaldParameters& params);
+size_t kVectorBound(const EwaldParameters& params);
+
+class ECE_Ewald {
+public:
+    // Pick parameters for the requested relative tolerance and precompute structure factors and the PME mesh.
+    // The solver keeps its own copy of the charges; callers should check the parameters against MAX_MESH_POINTS
+    // and MAX_K_VECTORS first.
+    ECE_Ewald(const ChargeArrays& charges, const PeriodicCell& cell, double tolerance, int numThreads);
+
+    // Electrostatic energy per unit cell (J), with the reciprocal part from Ewald or from the PME mesh.
+    // Non-neutral cells are treated with the uniform neutralising background.
+    double computeEnergy(bool useMesh) const;
+
+    // Field at a probe point (V/m) from all periodic images of the charges.
+    FieldSample computeFieldAt(const Point3D& probe, bool useMesh) const;
+
+    const EwaldParameters& getParameters() const;
+
+private:
+    // Real-space part of the energy: every periodic image of every charge within the real-space cutoff.
+    double realSpaceEnergy() const;
+
+    // Real-space part of the field at a probe.
+    FieldSample realSpaceField(const Point3D& probe) const;
+
+    // Reciprocal-space energy and field from the explicit k-vector sum.
+    double reciprocalEnergy() const;
+    FieldSample reciprocalField(const Point3D& probe) const;
+
+    // Reciprocal-space energy and field from the PME mesh.
+    double meshEnergy() const;
+    FieldSample meshField(const Point3D& probe) const;
+
+    // Bucket the charges, wrapped into the cell, into bins no smaller than the real-space cutoff.
+    void buildRealSpaceBins();
+
+    // Bin and wrapped coordinate of a position along one axis.
+    int binAlong(double position, int axis, double &wrapped) const;
+
+    // Call visit(j, dx, dy, dz, r2) for every charge image within the real-space cutoff of a wrapped position.
+    template <typename Visit>
+    void forEachImageNear(const double wrapped[3], const int bin[3], Visit visit) const;
+
+    // Spread the charges on the mesh, convolve with the influence function and keep the potential mesh.
+    void buildMesh();
+
+    // Cubic B-spline weights and derivatives for a coordinate along one axis.
+    void splineWeights(double position, double origin, double length, int meshSize, int &firstIndex,
+                       double weights[4], double derivatives[4]) const;
+
+    const ChargeArrays charges;
+    PeriodicCell cell;
+    EwaldParameters params;
+    int numThreads;
+    double volume;
+    double totalCharge;
+    double sumSquaredCharge;
+
+    double lengths[3];
+    double origins[3];
+    int bins[3];                                    // Real-space bins per axis
+    int reach[3];                                   // Bins to search on either side to cover the cutoff
+    std::vector<double> wrappedX, wrappedY, wrappedZ;   // Charge positions relative to the cell origin, in [0, L)
+    std::vector<int> binStart;                      // Offsets of each bin in binIndex (size numBins + 1)
+    std::vector<int> binIndex;                      // Charge indices ordered by bin
+
+    std::vector<double> kx, ky, kz;                 // Reciprocal vectors with k != 0 and half-space symmetry
+    std::vector<double> kWeight;                    // 2 * (4 pi K / V) exp(-k^2 / 4 alpha^2) / k^2
+    std::vector<std::complex<double>> structure;    // S(k) = sum_j q_j exp(i k . r_j)
+
+    std::vector<double> chargeMesh;                 // Spread charges Q(g)
+    std::vector<double> potentialMesh;              // Phi(g) = (theta * Q)(g)
+};
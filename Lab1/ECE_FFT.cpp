@@ -0,0 +1,87 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Contains a small in-project radix-2 FFT used by the particle-mesh Ewald solver.
+*/
+
+#include "ECE_FFT.h"
+#include "ECE_ElectricFieldUtils.h"
+#include <thread>
+#include <cmath>
+#include <utility>
+
+// Check if n is a power of two.
+bool isPowerOfTwo(size_t n) {
+    return n > 0 && (n & (n - 1)) == 0;
+}
+
+// Smallest power of two that is >= n.
+size_t nextPowerOfTwo(size_t n) {
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+// In-place iterative Cooley-Tukey transform: bit-reversal permutation followed by log2(n) butterfly passes.
+void fft1D(std::complex<double>* data, size_t n, size_t stride, bool inverse) {
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(data[i * stride], data[j * stride]);
+        }
+    }
+
+    const double sign = inverse ? 1.0 : -1.0;
+    for (size_t len = 2; len <= n; len <<= 1) {
+        double angle = sign * 2.0 * M_PI / static_cast<double>(len);
+        std::complex<double> step(std::cos(angle), std::sin(angle));
+        for (size_t start = 0; start < n; start += len) {
+            std::complex<double> w(1.0, 0.0);
+            for (size_t k = 0; k < len / 2; ++k) {
+                std::complex<double>& a = data[(start + k) * stride];
+                std::complex<double>& b = data[(start + k + len / 2) * stride];
+                std::complex<double> t = w * b;
+                b = a - t;
+                a += t;
+                w *= step;
+            }
+        }
+    }
+}
+
+// Transform every line along one axis. Lines are numbered 0..numLines-1 and mapped to their first element.
+static void transformLines(std::complex<double>* data, size_t n, size_t stride, size_t numLines,
+                           size_t innerCount, size_t outerStride, bool inverse, int numThreads) {
+    auto ranges = calculateDataDistribution(static_cast<int>(numLines), std::max(1, numThreads));
+    std::vector<std::thread> threads(ranges.size());
+    for (size_t t = 0; t < ranges.size(); ++t) {
+        threads[t] = std::thread([=](int start, int end) {
+            for (int line = start; line < end; ++line) {
+                size_t outer = line / innerCount;
+                size_t inner = line % innerCount;
+                fft1D(data + outer * outerStride + inner, n, stride, inverse);
+            }
+        }, ranges[t].start, ranges[t].end);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+// In-place unnormalised 3D FFT of an n1 x n2 x n3 row-major mesh.
+void fft3D(std::vector<std::complex<double>>& data, size_t n1, size_t n2, size_t n3, bool inverse, int numThreads) {
+    std::complex<double>* mesh = data.data();
+    // Axis 3: contiguous lines, one per (i1, i2)
+    transformLines(mesh, n3, 1, n1 * n2, 1, n3, inverse, numThreads);
+    // Axis 2: stride n3, one line per (i1, i3)
+    transformLines(mesh, n2, n3, n1 * n3, n3, n2 * n3, inverse, numThreads);
+    // Axis 1: stride n2 * n3, one line per (i2, i3)
+    transformLines(mesh, n1, n2 * n3, n2 * n3, n2 * n3, 0, inverse, numThreads);
+}
@@ -0,0 +1,26 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Contains a small in-project radix-2 FFT used by the particle-mesh Ewald solver.
+*/
+
+#pragma once
+
+#include <complex>
+#include <vector>
+#include <cstddef>
+
+// Check if n is a power of two.
+bool isPowerOfTwo(size_t n);
+
+// Smallest power of two that is >= n.
+size_t nextPowerOfTwo(size_t n);
+
+// In-place unnormalised FFT of n (power of two) elements spaced stride apart.
+// The forward transform uses exp(-2 pi i jk/n), the inverse exp(+2 pi i jk/n).
+void fft1D(std::complex<double>* data, size_t n, size_t stride, bool inverse);
+
+// In-place unnormalised 3D FFT of an n1 x n2 x n3 row-major mesh (index (i1 * n2 + i2) * n3 + i3),
+// with the lines along each axis split across numThreads threads.
+void fft3D(std::vector<std::complex<double>>& data, size_t n1, size_t n2, size_t n3, bool inverse, int numThreads);
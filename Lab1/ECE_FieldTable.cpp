@@ -0,0 +1,349 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Contains the precomputed field table. Patches hold the field at 4 x 4 x 4 equispaced nodes and are
+interpolated with tricubic Lagrange weights. A patch is split into 8 octants while the interpolant misses the
+exact field at its 27 check points by more than the tolerance.
+*/
+
+#include "ECE_FieldTable.h"
+#include <thread>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+constexpr double K = 9e9;  // Coulomb's Constant
+
+// On-disk header followed by numNodes FieldTableNode and numLeaves FieldTableLeaf records
+struct FieldTableHeader {
+    char magic[8];
+    uint64_t numNodes;
+    uint64_t numLeaves;
+    double lower[3];
+    double upper[3];
+    double tolerance;
+    int32_t maxDepth;
+    int32_t reserved;
+};
+
+static const char FIELD_TABLE_MAGIC[8] = {'E', 'C', 'E', 'F', 'T', 'A', 'B', '1'};
+
+// Exact field of all charges at a point
+static void exactField(const ChargeArrays& charges, double x, double y, double z, double field[3]) {
+    field[0] = field[1] = field[2] = 0.0;
+    for (size_t j = 0; j < charges.size(); ++j) {
+        double dx = x - charges.x[j];
+        double dy = y - charges.y[j];
+        double dz = z - charges.z[j];
+        double r2 = dx * dx + dy * dy + dz * dz;
+        if (r2 == 0.0) {
+            continue;
+        }
+        double s = K * charges.q[j] / (r2 * std::sqrt(r2));
+        field[0] += s * dx;
+        field[1] += s * dy;
+        field[2] += s * dz;
+    }
+}
+
+// Cubic Lagrange weights for the nodes t = 0, 1/3, 2/3, 1
+static void lagrangeWeights(double t, double w[4]) {
+    const double a = 1.0 / 3.0, b = 2.0 / 3.0;
+    w[0] = -4.5 * (t - a) * (t - b) * (t - 1.0);
+    w[1] = 13.5 * t * (t - b) * (t - 1.0);
+    w[2] = -13.5 * t * (t - a) * (t - 1.0);
+    w[3] = 4.5 * t * (t - a) * (t - b);
+}
+
+// Interpolate a patch at local coordinates (tx, ty, tz) in [0, 1]^3
+static void interpolatePatch(const FieldTableLeaf& leaf, double tx, double ty, double tz, double field[3]) {
+    double wx[4], wy[4], wz[4];
+    lagrangeWeights(tx, wx);
+    lagrangeWeights(ty, wy);
+    lagrangeWeights(tz, wz);
+
+    for (int c = 0; c < 3; ++c) {
+        double sum = 0.0;
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                double wij = wx[i] * wy[j];
+                const double* line = &leaf.samples[c][(i * 4 + j) * 4];
+                sum += wij * (wz[0] * line[0] + wz[1] * line[1] + wz[2] * line[2] + wz[3] * line[3]);
+            }
+        }
+        field[c] = sum;
+    }
+}
+
+// Build the subtree for the box [lower, lower + size) into private node and leaf lists.
+void ECE_FieldTable::buildSubtree(const ChargeArrays& charges, const Point3D& boxLower, const Point3D& size, int depth,
+                                  std::vector<FieldTableNode>& nodeList, std::vector<FieldTableLeaf>& leafList, int nodeIndex) const {
+    FieldTableLeaf leaf;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            for (int k = 0; k < 4; ++k) {
+                double field[3];
+                exactField(charges, boxLower.x + size.x * i / 3.0, boxLower.y + size.y * j / 3.0, boxLower.z + size.z * k / 3.0, field);
+                for (int c = 0; c < 3; ++c) {
+                    leaf.samples[c][(i * 4 + j) * 4 + k] = field[c];
+                }
+            }
+        }
+    }
+
+    // Check points sit between the nodes, where the interpolation error peaks
+    const double checks[3] = {1.0 / 6.0, 0.5, 5.0 / 6.0};
+    double maxError = 0.0, maxField = 0.0;
+    for (double tx : checks) {
+        for (double ty : checks) {
+            for (double tz : checks) {
+                double exact[3], approx[3];
+                exactField(charges, boxLower.x + size.x * tx, boxLower.y + size.y * ty, boxLower.z + size.z * tz, exact);
+                interpolatePatch(leaf, tx, ty, tz, approx);
+                double dx = approx[0] - exact[0], dy = approx[1] - exact[1], dz = approx[2] - exact[2];
+                maxError = std::max(maxError, std::sqrt(dx * dx + dy * dy + dz * dz));
+                maxField = std::max(maxField, std::sqrt(exact[0] * exact[0] + exact[1] * exact[1] + exact[2] * exact[2]));
+            }
+        }
+    }
+    leaf.errorEstimate = (maxField > 0.0) ? maxError / maxField : 0.0;
+
+    if (leaf.errorEstimate <= tolerance || depth >= maxDepth) {
+        nodeList[nodeIndex].firstChild = -1;
+        nodeList[nodeIndex].leaf = static_cast<int32_t>(leafList.size());
+        leafList.push_back(leaf);
+        return;
+    }
+
+    int firstChild = static_cast<int>(nodeList.size());
+    nodeList[nodeIndex].firstChild = firstChild;
+    nodeList[nodeIndex].leaf = -1;
+    nodeList.resize(nodeList.size() + 8, FieldTableNode{-1, -1});
+
+    Point3D half = {size.x / 2, size.y / 2, size.z / 2};
+    for (int octant = 0; octant < 8; ++octant) {
+        Point3D childLower = {boxLower.x + ((octant & 1) ? half.x : 0.0),
+                              boxLower.y + ((octant & 2) ? half.y : 0.0),
+                              boxLower.z + ((octant & 4) ? half.z : 0.0)};
+        buildSubtree(charges, childLower, half, depth + 1, nodeList, leafList, firstChild + octant);
+    }
+}
+
+// Sample the field of the charges over [lower, upper]. The top two levels are always split so the
+// 64 resulting subtrees can be built independently on the worker threads and spliced together.
+ECE_FieldTable::ECE_FieldTable(const ChargeArrays& charges, const Point3D& lower, const Point3D& upper,
+                               double tolerance, int maxDepth, int numThreads)
+    : lower(lower), upper(upper), tolerance(tolerance), maxDepth(maxDepth),
+      nodes(nullptr), leaves(nullptr), numNodes(0), numLeaves(0), mapping(nullptr), mappingSize(0) {
+    Point3D size = {upper.x - lower.x, upper.y - lower.y, upper.z - lower.z};
+
+    if (maxDepth < 2) {
+        ownedNodes.assign(1, FieldTableNode{-1, -1});
+        buildSubtree(charges, lower, size, 0, ownedNodes, ownedLeaves, 0);
+    } else {
+        const int numSubtrees = 64;
+        const int subtreeBase = 9;  // Root, 8 first-level nodes, then the 64 subtree roots
+        ownedNodes.assign(subtreeBase + numSubtrees, FieldTableNode{-1, -1});
+        ownedNodes[0].firstChild = 1;
+        for (int i = 0; i < 8; ++i) {
+            ownedNodes[1 + i].firstChild = subtreeBase + 8 * i;
+        }
+
+        std::vector<std::vector<FieldTableNode>> subtreeNodes(numSubtrees);
+        std::vector<std::vector<FieldTableLeaf>> subtreeLeaves(numSubtrees);
+        Point3D quarter = {size.x / 4, size.y / 4, size.z / 4};
+
+        auto ranges = calculateDataDistribution(numSubtrees, std::max(1, numThreads));
+        std::vector<std::thread> threads(ranges.size());
+        for (size_t t = 0; t < ranges.size(); ++t) {
+            threads[t] = std::thread([&](int start, int end) {
+                for (int s = start; s < end; ++s) {
+                    int parent = s / 8, octant = s % 8;
+                    Point3D subtreeLower = {lower.x + ((parent & 1) ? 2 * quarter.x : 0.0) + ((octant & 1) ? quarter.x : 0.0),
+                                            lower.y + ((parent & 2) ? 2 * quarter.y : 0.0) + ((octant & 2) ? quarter.y : 0.0),
+                                            lower.z + ((parent & 4) ? 2 * quarter.z : 0.0) + ((octant & 4) ? quarter.z : 0.0)};
+                    subtreeNodes[s].assign(1, FieldTableNode{-1, -1});
+                    buildSubtree(charges, subtreeLower, quarter, 2, subtreeNodes[s], subtreeLeaves[s], 0);
+                }
+            }, ranges[t].start, ranges[t].end);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        // Splice: local node 0 becomes the subtree root slot, local nodes 1.. are appended
+        for (int s = 0; s < numSubtrees; ++s) {
+            int nodeBase = static_cast<int>(ownedNodes.size()) - 1;
+            int leafBase = static_cast<int>(ownedLeaves.size());
+            auto remap = [&](FieldTableNode node) {
+                if (node.firstChild >= 0) {
+                    node.firstChild += nodeBase;
+                }
+                if (node.leaf >= 0) {
+                    node.leaf += leafBase;
+                }
+                return node;
+            };
+            ownedNodes[subtreeBase + s] = remap(subtreeNodes[s][0]);
+            for (size_t l = 1; l < subtreeNodes[s].size(); ++l) {
+                ownedNodes.push_back(remap(subtreeNodes[s][l]));
+            }
+            ownedLeaves.insert(ownedLeaves.end(), subtreeLeaves[s].begin(), subtreeLeaves[s].end());
+        }
+    }
+
+    nodes = ownedNodes.data();
+    leaves = ownedLeaves.data();
+    numNodes = ownedNodes.size();
+    numLeaves = ownedLeaves.size();
+}
+
+// Check the tree a lookup will walk: every inner node's 8 children lie after it and inside the node array, and
+// every leaf node names an existing patch. Children after their parent also rule out cycles.
+static bool validateNodes(const FieldTableNode* nodes, uint64_t numNodes, uint64_t numLeaves) {
+    for (uint64_t n = 0; n < numNodes; ++n) {
+        const FieldTableNode& node = nodes[n];
+        if (node.firstChild >= 0) {
+            if (static_cast<uint64_t>(node.firstChild) <= n || static_cast<uint64_t>(node.firstChild) + 7 >= numNodes) {
+                return false;
+            }
+        } else if (node.leaf < 0 || static_cast<uint64_t>(node.leaf) >= numLeaves) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Memory-map a table saved with save(), refusing files whose sizes or node links are inconsistent.
+ECE_FieldTable::ECE_FieldTable(const std::string& path)
+    : lower({0, 0, 0}), upper({0, 0, 0}), tolerance(0), maxDepth(0),
+      nodes(nullptr), leaves(nullptr), numNodes(0), numLeaves(0), mapping(nullptr), mappingSize(0) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(FieldTableHeader)) {
+        close(fd);
+        return;
+    }
+    void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return;
+    }
+
+    // Check the sizes against the file before multiplying them, so a corrupt count cannot overflow the product
+    const FieldTableHeader* header = static_cast<const FieldTableHeader*>(data);
+    size_t payload = static_cast<size_t>(info.st_size) - sizeof(FieldTableHeader);
+    bool consistent = std::memcmp(header->magic, FIELD_TABLE_MAGIC, 8) == 0 && header->numNodes > 0
+                      && header->numNodes <= payload / sizeof(FieldTableNode) && header->numLeaves <= payload / sizeof(FieldTableLeaf)
+                      && header->numNodes * sizeof(FieldTableNode) + header->numLeaves * sizeof(FieldTableLeaf) == payload;
+    if (consistent) {
+        const FieldTableNode* fileNodes = reinterpret_cast<const FieldTableNode*>(static_cast<const char*>(data) + sizeof(FieldTableHeader));
+        consistent = validateNodes(fileNodes, header->numNodes, header->numLeaves);
+    }
+    if (!consistent) {
+        munmap(data, info.st_size);
+        return;
+    }
+
+    mapping = data;
+    mappingSize = info.st_size;
+    lower = {header->lower[0], header->lower[1], header->lower[2]};
+    upper = {header->upper[0], header->upper[1], header->upper[2]};
+    tolerance = header->tolerance;
+    maxDepth = header->maxDepth;
+    numNodes = header->numNodes;
+    numLeaves = header->numLeaves;
+    nodes = reinterpret_cast<const FieldTableNode*>(static_cast<const char*>(data) + sizeof(FieldTableHeader));
+    leaves = reinterpret_cast<const FieldTableLeaf*>(reinterpret_cast<const char*>(nodes) + numNodes * sizeof(FieldTableNode));
+}
+
+// Unmap a loaded table.
+ECE_FieldTable::~ECE_FieldTable() {
+    if (mapping != nullptr) {
+        munmap(mapping, mappingSize);
+    }
+}
+
+// Check if a loaded table was mapped successfully.
+bool ECE_FieldTable::isValid() const {
+    return nodes != nullptr;
+}
+
+// Write the table to disk.
+bool ECE_FieldTable::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    FieldTableHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, FIELD_TABLE_MAGIC, 8);
+    header.numNodes = numNodes;
+    header.numLeaves = numLeaves;
+    header.lower[0] = lower.x;
+    header.lower[1] = lower.y;
+    header.lower[2] = lower.z;
+    header.upper[0] = upper.x;
+    header.upper[1] = upper.y;
+    header.upper[2] = upper.z;
+    header.tolerance = tolerance;
+    header.maxDepth = maxDepth;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(nodes), numNodes * sizeof(FieldTableNode));
+    file.write(reinterpret_cast<const char*>(leaves), numLeaves * sizeof(FieldTableLeaf));
+    return static_cast<bool>(file);
+}
+
+// Interpolate the field at a point: descend to the leaf containing it (at most maxDepth levels) and evaluate the patch.
+FieldTableSample ECE_FieldTable::lookup(const Point3D& point) const {
+    FieldTableSample sample = {0.0, 0.0, 0.0, 0.0, false};
+    if (point.x < lower.x || point.y < lower.y || point.z < lower.z ||
+        point.x > upper.x || point.y > upper.y || point.z > upper.z) {
+        return sample;
+    }
+
+    // Work in unit-cube coordinates and rescale at every level
+    double tx = (point.x - lower.x) / (upper.x - lower.x);
+    double ty = (point.y - lower.y) / (upper.y - lower.y);
+    double tz = (point.z - lower.z) / (upper.z - lower.z);
+    int32_t node = 0;
+    while (nodes[node].firstChild >= 0) {
+        int octant = 0;
+        if (tx >= 0.5) { octant |= 1; tx -= 0.5; }
+        if (ty >= 0.5) { octant |= 2; ty -= 0.5; }
+        if (tz >= 0.5) { octant |= 4; tz -= 0.5; }
+        tx *= 2.0;
+        ty *= 2.0;
+        tz *= 2.0;
+        node = nodes[node].firstChild + octant;
+    }
+
+    const FieldTableLeaf& leaf = leaves[nodes[node].leaf];
+    double field[3];
+    interpolatePatch(leaf, tx, ty, tz, field);
+    sample.Ex = field[0];
+    sample.Ey = field[1];
+    sample.Ez = field[2];
+    sample.errorEstimate = leaf.errorEstimate;
+    sample.inside = true;
+    return sample;
+}
+
+size_t ECE_FieldTable::getNumNodes() const {
+    return numNodes;
+}
+
+size_t ECE_FieldTable::getNumLeaves() const {
+    return numLeaves;
+}
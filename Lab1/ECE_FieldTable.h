@@ -0,0 +1,88 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Contains the precomputed field table. The field of a fixed charge set is sampled once onto an
+adaptive octree of tricubic patches over a box; point queries are then answered by interpolation together
+with the error estimate sampled when the patch was built. Tables can be saved and memory-mapped later.
+*/
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "ECE_ElectricFieldUtils.h"
+#include "ECE_CoulombInteractions.h"
+
+// Octree node. Children of a node are stored as 8 consecutive nodes in (x, y, z) bit order.
+struct FieldTableNode {
+    int32_t firstChild;  // Index of the first child, or -1 for a leaf
+    int32_t leaf;        // Index of the leaf patch, or -1 for an inner node
+};
+
+// Tricubic patch: field components at the 4 x 4 x 4 equispaced nodes of the cell
+struct FieldTableLeaf {
+    double samples[3][64];   // [component][(i * 4 + j) * 4 + k] for node (x_i, y_j, z_k)
+    double errorEstimate;    // Largest relative error seen at the check points of the patch
+};
+
+// Interpolated field at a query point
+struct FieldTableSample {
+    double Ex;
+    double Ey;
+    double Ez;
+    double errorEstimate;   // Sampled relative error of the patch that answered the query (an estimate, not a bound)
+    bool inside;            // False if the point is outside the table region (field is then zero)
+};
+
+class ECE_FieldTable {
+public:
+    // Sample the field of the charges over [lower, upper], refining patches until the relative error is below
+    // tolerance or maxDepth is reached. Construction is spread across numThreads threads.
+    ECE_FieldTable(const ChargeArrays& charges, const Point3D& lower, const Point3D& upper,
+                   double tolerance, int maxDepth, int numThreads);
+
+    // Memory-map a table saved with save(); a truncated or inconsistent file leaves the table invalid.
+    explicit ECE_FieldTable(const std::string& path);
+
+    // Unmap a loaded table.
+    ~ECE_FieldTable();
+
+    ECE_FieldTable(const ECE_FieldTable&) = delete;
+    ECE_FieldTable& operator=(const ECE_FieldTable&) = delete;
+
+    // Check if a loaded table was mapped successfully.
+    bool isValid() const;
+
+    // Write the table to disk.
+    bool save(const std::string& path) const;
+
+    // Interpolate the field at a point.
+    FieldTableSample lookup(const Point3D& point) const;
+
+    // Table size.
+    size_t getNumNodes() const;
+    size_t getNumLeaves() const;
+
+private:
+    // Build the subtree for the box [lower, lower + size) into private node and leaf lists.
+    void buildSubtree(const ChargeArrays& charges, const Point3D& lower, const Point3D& size, int depth,
+                      std::vector<FieldTableNode>& nodes, std::vector<FieldTableLeaf>& leaves, int nodeIndex) const;
+
+    Point3D lower;
+    Point3D upper;
+    double tolerance;
+    int maxDepth;
+
+    std::vector<FieldTableNode> ownedNodes;
+    std::vector<FieldTableLeaf> ownedLeaves;
+    const FieldTableNode* nodes;
+    const FieldTableLeaf* leaves;
+    size_t numNodes;
+    size_t numLeaves;
+
+    void* mapping;          // Memory-mapped file when loaded from disk
+    size_t mappingSize;
+};
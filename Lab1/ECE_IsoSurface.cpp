@@ -0,0 +1,266 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Contains the equipotential-surface extraction stage. Each lattice cube is split into six
+tetrahedra around its main diagonal (the split is consistent across neighbouring cubes, so the surface is
+watertight and needs only the 16 tetrahedron cases instead of the 256-entry cube tables). Surface vertices
+are keyed by the lattice edge they lie on, which makes deduplication within and across blocks exact.
+*/
+
+#include "ECE_IsoSurface.h"
+#include <thread>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <unordered_map>
+#include <algorithm>
+
+constexpr double K = 9e9;  // Coulomb's Constant
+
+// Six tetrahedra sharing the cube diagonal 0-7 (corner bits: x = 1, y = 2, z = 4)
+static const int CUBE_TETRAHEDRA[6][4] = {
+    {0, 1, 3, 7}, {0, 3, 2, 7}, {0, 2, 6, 7}, {0, 6, 4, 7}, {0, 4, 5, 7}, {0, 5, 1, 7}
+};
+
+// Surface pieces produced by one block of the lattice, with block-local vertex numbering
+struct IsoBlock {
+    std::vector<uint64_t> edgeKeys;
+    std::vector<Point3D> vertices;
+    std::vector<unsigned int> indices;
+};
+
+// Sample the potential of the charges at every lattice point, split across numThreads threads.
+ECE_PotentialLattice::ECE_PotentialLattice(const ChargeArrays& charges, const LatticeSpec& spec, int numThreads)
+    : charges(charges), spec(spec), potential(static_cast<size_t>(spec.nx) * spec.ny * spec.nz, 0.0) {
+    auto ranges = calculateDataDistribution(spec.nz, std::max(1, numThreads));
+    std::vector<std::thread> threads(ranges.size());
+    for (size_t t = 0; t < ranges.size(); ++t) {
+        threads[t] = std::thread([this](int start, int end) {
+            for (int k = start; k < end; ++k) {
+                for (int j = 0; j < this->spec.ny; ++j) {
+                    for (int i = 0; i < this->spec.nx; ++i) {
+                        Point3D p = position(i, j, k);
+                        double phi = 0.0;
+                        for (size_t c = 0; c < this->charges.size(); ++c) {
+                            double dx = p.x - this->charges.x[c];
+                            double dy = p.y - this->charges.y[c];
+                            double dz = p.z - this->charges.z[c];
+                            double r = std::sqrt(dx * dx + dy * dy + dz * dz);
+                            // A lattice point on a charge gets the largest finite value so it reads as "inside"
+                            phi += (r > 0.0) ? K * this->charges.q[c] / r : std::copysign(1e300, this->charges.q[c]);
+                        }
+                        potential[index(i, j, k)] = phi;
+                    }
+                }
+            }
+        }, ranges[t].start, ranges[t].end);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+// Lattice point position.
+Point3D ECE_PotentialLattice::position(int i, int j, int k) const {
+    return Point3D{spec.lower.x + (spec.upper.x - spec.lower.x) * i / (spec.nx - 1),
+                   spec.lower.y + (spec.upper.y - spec.lower.y) * j / (spec.ny - 1),
+                   spec.lower.z + (spec.upper.z - spec.lower.z) * k / (spec.nz - 1)};
+}
+
+// Flat index of a lattice point.
+size_t ECE_PotentialLattice::index(int i, int j, int k) const {
+    return (static_cast<size_t>(k) * spec.ny + j) * spec.nx + i;
+}
+
+// Smallest and largest sampled potential.
+void ECE_PotentialLattice::getRange(double &minPotential, double &maxPotential) const {
+    auto range = std::minmax_element(potential.begin(), potential.end());
+    minPotential = *range.first;
+    maxPotential = *range.second;
+}
+
+// Extract the surface potential == isoLevel.
+IsoMesh ECE_PotentialLattice::extractIsoSurface(double isoLevel, int numThreads) const {
+    const uint64_t numPoints = potential.size();
+    int numSlabs = spec.nz - 1;
+    auto ranges = calculateDataDistribution(numSlabs, std::max(1, numThreads));
+    std::vector<IsoBlock> blocks(ranges.size());
+    std::vector<std::thread> threads(ranges.size());
+
+    for (size_t t = 0; t < ranges.size(); ++t) {
+        threads[t] = std::thread([&, t](int start, int end) {
+            IsoBlock& block = blocks[t];
+            std::unordered_map<uint64_t, unsigned int> localVertex;
+
+            // Vertex on lattice edge (a, b), created once per block
+            auto edgeVertex = [&](size_t a, size_t b, const Point3D& pa, const Point3D& pb) {
+                uint64_t key = std::min(a, b) * numPoints + std::max(a, b);
+                auto found = localVertex.find(key);
+                if (found != localVertex.end()) {
+                    return found->second;
+                }
+                double s = (isoLevel - potential[a]) / (potential[b] - potential[a]);
+                unsigned int id = static_cast<unsigned int>(block.vertices.size());
+                block.vertices.push_back(Point3D{pa.x + s * (pb.x - pa.x), pa.y + s * (pb.y - pa.y), pa.z + s * (pb.z - pa.z)});
+                block.edgeKeys.push_back(key);
+                localVertex.emplace(key, id);
+                return id;
+            };
+
+            // Emit a triangle whose normal points away from the inside (potential above the level) corners
+            auto emitTriangle = [&](unsigned int v0, unsigned int v1, unsigned int v2, const Point3D& insideCentre) {
+                const Point3D& a = block.vertices[v0];
+                const Point3D& b = block.vertices[v1];
+                const Point3D& c = block.vertices[v2];
+                double ux = b.x - a.x, uy = b.y - a.y, uz = b.z - a.z;
+                double wx = c.x - a.x, wy = c.y - a.y, wz = c.z - a.z;
+                double nx = uy * wz - uz * wy, ny = uz * wx - ux * wz, nz = ux * wy - uy * wx;
+                double ox = (a.x + b.x + c.x) / 3 - insideCentre.x;
+                double oy = (a.y + b.y + c.y) / 3 - insideCentre.y;
+                double oz = (a.z + b.z + c.z) / 3 - insideCentre.z;
+                if (nx * ox + ny * oy + nz * oz < 0.0) {
+                    std::swap(v1, v2);
+                }
+                block.indices.push_back(v0);
+                block.indices.push_back(v1);
+                block.indices.push_back(v2);
+            };
+
+            for (int k = start; k < end; ++k) {
+                for (int j = 0; j < spec.ny - 1; ++j) {
+                    for (int i = 0; i < spec.nx - 1; ++i) {
+                        size_t corner[8];
+                        Point3D cornerPos[8];
+                        for (int c = 0; c < 8; ++c) {
+                            int ci = i + (c & 1), cj = j + ((c >> 1) & 1), ck = k + ((c >> 2) & 1);
+                            corner[c] = index(ci, cj, ck);
+                            cornerPos[c] = position(ci, cj, ck);
+                        }
+
+                        for (const auto& tet : CUBE_TETRAHEDRA) {
+                            int inside[4], outside[4], numInside = 0, numOutside = 0;
+                            for (int v : tet) {
+                                if (potential[corner[v]] > isoLevel) {
+                                    inside[numInside++] = v;
+                                } else {
+                                    outside[numOutside++] = v;
+                                }
+                            }
+                            if (numInside == 0 || numInside == 4) {
+                                continue;
+                            }
+
+                            Point3D centre = {0.0, 0.0, 0.0};
+                            for (int n = 0; n < numInside; ++n) {
+                                centre.x += cornerPos[inside[n]].x / numInside;
+                                centre.y += cornerPos[inside[n]].y / numInside;
+                                centre.z += cornerPos[inside[n]].z / numInside;
+                            }
+
+                            auto vertexOn = [&](int a, int b) {
+                                return edgeVertex(corner[a], corner[b], cornerPos[a], cornerPos[b]);
+                            };
+
+                            if (numInside == 1) {
+                                emitTriangle(vertexOn(inside[0], outside[0]), vertexOn(inside[0], outside[1]), vertexOn(inside[0], outside[2]), centre);
+                            } else if (numInside == 3) {
+                                emitTriangle(vertexOn(outside[0], inside[0]), vertexOn(outside[0], inside[1]), vertexOn(outside[0], inside[2]), centre);
+                            } else {
+                                // Quad through the four edges between the inside and outside pairs
+                                unsigned int q0 = vertexOn(inside[0], outside[0]);
+                                unsigned int q1 = vertexOn(inside[0], outside[1]);
+                                unsigned int q2 = vertexOn(inside[1], outside[1]);
+                                unsigned int q3 = vertexOn(inside[1], outside[0]);
+                                emitTriangle(q0, q1, q2, centre);
+                                emitTriangle(q0, q2, q3, centre);
+                            }
+                        }
+                    }
+                }
+            }
+        }, ranges[t].start, ranges[t].end);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Merge the blocks; vertices on the slab boundaries share edge keys and collapse to one
+    IsoMesh mesh;
+    std::unordered_map<uint64_t, unsigned int> globalVertex;
+    for (const auto& block : blocks) {
+        std::vector<unsigned int> remap(block.vertices.size());
+        for (size_t v = 0; v < block.vertices.size(); ++v) {
+            auto inserted = globalVertex.emplace(block.edgeKeys[v], static_cast<unsigned int>(mesh.vertices.size()));
+            if (inserted.second) {
+                mesh.vertices.push_back(block.vertices[v]);
+            }
+            remap[v] = inserted.first->second;
+        }
+        for (unsigned int id : block.indices) {
+            mesh.indices.push_back(remap[id]);
+        }
+    }
+
+    // Normals from the exact field, which is normal to the equipotential and points towards lower potential
+    mesh.normals.resize(mesh.vertices.size());
+    if (!mesh.vertices.empty()) {
+        auto vertexRanges = calculateDataDistribution(static_cast<int>(mesh.vertices.size()), std::max(1, numThreads));
+        threads.clear();
+        threads.resize(vertexRanges.size());
+        for (size_t t = 0; t < vertexRanges.size(); ++t) {
+            threads[t] = std::thread([&](int start, int end) {
+                for (int v = start; v < end; ++v) {
+                    const Point3D& p = mesh.vertices[v];
+                    double Ex = 0.0, Ey = 0.0, Ez = 0.0;
+                    for (size_t c = 0; c < charges.size(); ++c) {
+                        double dx = p.x - charges.x[c], dy = p.y - charges.y[c], dz = p.z - charges.z[c];
+                        double r2 = dx * dx + dy * dy + dz * dz;
+                        if (r2 == 0.0) {
+                            continue;
+                        }
+                        double s = K * charges.q[c] / (r2 * std::sqrt(r2));
+                        Ex += s * dx;
+                        Ey += s * dy;
+                        Ez += s * dz;
+                    }
+                    double length = std::sqrt(Ex * Ex + Ey * Ey + Ez * Ez);
+                    mesh.normals[v] = (length > 0.0) ? Point3D{Ex / length, Ey / length, Ez / length} : Point3D{0.0, 0.0, 1.0};
+                }
+            }, vertexRanges[t].start, vertexRanges[t].end);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    return mesh;
+}
+
+// Write a mesh as OBJ. loadOBJ needs v/vt/vn on every face corner, so each vertex gets a placeholder UV
+// with the same index as its position and normal.
+bool writeOBJ(const IsoMesh& mesh, const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+
+    std::fprintf(file, "# Equipotential surface: %zu vertices, %zu triangles\n", mesh.vertices.size(), mesh.indices.size() / 3);
+    for (const auto& v : mesh.vertices) {
+        std::fprintf(file, "v %.7g %.7g %.7g\n", v.x, v.y, v.z);
+    }
+    for (size_t v = 0; v < mesh.vertices.size(); ++v) {
+        std::fprintf(file, "vt 0 0\n");
+    }
+    for (const auto& n : mesh.normals) {
+        std::fprintf(file, "vn %.6f %.6f %.6f\n", n.x, n.y, n.z);
+    }
+    for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        unsigned int a = mesh.indices[t] + 1, b = mesh.indices[t + 1] + 1, c = mesh.indices[t + 2] + 1;
+        std::fprintf(file, "f %u/%u/%u %u/%u/%u %u/%u/%u\n", a, a, a, b, b, b, c, c, c);
+    }
+
+    bool ok = std::ferror(file) == 0;
+    std::fclose(file);
+    return ok;
+}
@@ -0,0 +1,56 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Contains the equipotential-surface extraction stage. The scalar potential of a charge set is
+sampled on a 3D lattice and iso-surfaces are extracted block by block into deduplicated indexed meshes that
+can be written as OBJ files for the objloader/vboindexer path in Final_Project/common.
+*/
+
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "ECE_ElectricFieldUtils.h"
+#include "ECE_CoulombInteractions.h"
+
+// Region and resolution of the potential lattice
+struct LatticeSpec {
+    Point3D lower;
+    Point3D upper;
+    int nx, ny, nz;   // Lattice points per axis (>= 2)
+};
+
+// Indexed triangle mesh with one unit normal per vertex
+struct IsoMesh {
+    std::vector<Point3D> vertices;
+    std::vector<Point3D> normals;
+    std::vector<unsigned int> indices;   // Three per triangle, counter-clockwise seen from the low-potential side
+};
+
+class ECE_PotentialLattice {
+public:
+    // Sample the potential (V) of the charges at every lattice point, split across numThreads threads.
+    // The lattice keeps its own copy of the charges.
+    ECE_PotentialLattice(const ChargeArrays& charges, const LatticeSpec& spec, int numThreads);
+
+    // Extract the surface potential == isoLevel. Blocks of z-slabs are processed in parallel and their
+    // vertices are merged by lattice edge so shared vertices appear once.
+    IsoMesh extractIsoSurface(double isoLevel, int numThreads) const;
+
+    // Smallest and largest sampled potential.
+    void getRange(double &minPotential, double &maxPotential) const;
+
+private:
+    // Lattice point position and flat index.
+    Point3D position(int i, int j, int k) const;
+    size_t index(int i, int j, int k) const;
+
+    const ChargeArrays charges;
+    LatticeSpec spec;
+    std::vector<double> potential;
+};
+
+// Write a mesh as OBJ with v/vt/vn/f records in the 9-index face form loadOBJ expects.
+bool writeOBJ(const IsoMesh& mesh, const std::string& path);
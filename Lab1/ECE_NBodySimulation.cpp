@@ -0,0 +1,128 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Contains the electrostatic N-body integrator (velocity Verlet) and the binary trajectory writer.
+*/
+
+#include "ECE_NBodySimulation.h"
+#include "ECE_CellList.h"
+
+// Open the trajectory file and write its header.
+ECE_TrajectoryWriter::ECE_TrajectoryWriter(const std::string& path, size_t numParticles)
+    : file(path, std::ios::binary), buffer(numParticles) {
+    if (file) {
+        uint64_t count = numParticles;
+        file.write("ECETRAJ1", 8);
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+}
+
+// Check if the file was opened successfully.
+bool ECE_TrajectoryWriter::isOpen() const {
+    return static_cast<bool>(file);
+}
+
+// Append one snapshot of the particle positions.
+void ECE_TrajectoryWriter::writeSnapshot(uint64_t step, double time, const ChargeArrays& state) {
+    file.write(reinterpret_cast<const char*>(&step), sizeof(step));
+    file.write(reinterpret_cast<const char*>(&time), sizeof(time));
+    for (const std::vector<double>* axis : {&state.x, &state.y, &state.z}) {
+        for (size_t i = 0; i < buffer.size(); ++i) {
+            buffer[i] = static_cast<float>((*axis)[i]);
+        }
+        file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(float));
+    }
+}
+
+// Constructor to copy the particles into SoA state and evaluate the initial forces.
+ECE_NBodySimulation::ECE_NBodySimulation(const std::vector<ECE_ChargedParticle>& particles, int numThreads, double cutoff)
+    : state(packCharges(particles)), numThreads(numThreads), cutoff(cutoff), stepCount(0), time(0.0) {
+    for (const auto& particle : particles) {
+        double pvx, pvy, pvz;
+        particle.getVelocity(pvx, pvy, pvz);
+        vx.push_back(pvx);
+        vy.push_back(pvy);
+        vz.push_back(pvz);
+        mass.push_back(particle.getMass());
+        invMass.push_back(1.0 / particle.getMass());
+    }
+    computeForces();
+}
+
+// Evaluate forces and potential energy for the current positions.
+void ECE_NBodySimulation::computeForces() {
+    if (cutoff > 0.0) {
+        // Rebuilding the cell list is O(N); shifted forces keep the energy smooth as pairs cross the cutoff
+        ECE_CellList cells(state, cutoff, true);
+        forces = cells.computeInteractions(numThreads);
+    } else {
+        forces = computeCoulombInteractions(state, numThreads);
+    }
+}
+
+// Advance the system by one velocity-Verlet step: half kick, drift, new forces, half kick.
+void ECE_NBodySimulation::step(double dt) {
+    size_t n = state.size();
+    double halfDt = 0.5 * dt;
+
+    for (size_t i = 0; i < n; ++i) {
+        double h = halfDt * invMass[i];
+        vx[i] += h * forces.Fx[i];
+        vy[i] += h * forces.Fy[i];
+        vz[i] += h * forces.Fz[i];
+        state.x[i] += dt * vx[i];
+        state.y[i] += dt * vy[i];
+        state.z[i] += dt * vz[i];
+    }
+
+    computeForces();
+
+    for (size_t i = 0; i < n; ++i) {
+        double h = halfDt * invMass[i];
+        vx[i] += h * forces.Fx[i];
+        vy[i] += h * forces.Fy[i];
+        vz[i] += h * forces.Fz[i];
+    }
+
+    ++stepCount;
+    time += dt;
+}
+
+// Kinetic energy of the particles in J.
+double ECE_NBodySimulation::getKineticEnergy() const {
+    CompensatedSum energy;
+    for (size_t i = 0; i < state.size(); ++i) {
+        energy.add(0.5 * mass[i] * (vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i]));
+    }
+    return energy.value();
+}
+
+// Electrostatic potential energy of the current configuration in J.
+double ECE_NBodySimulation::getPotentialEnergy() const {
+    return forces.potentialEnergy;
+}
+
+uint64_t ECE_NBodySimulation::getStepCount() const {
+    return stepCount;
+}
+
+double ECE_NBodySimulation::getTime() const {
+    return time;
+}
+
+// Current particle positions and charges.
+const ChargeArrays& ECE_NBodySimulation::getState() const {
+    return state;
+}
+
+// Copy the current state back into particle objects (charges converted back to micro C).
+std::vector<ECE_ChargedParticle> ECE_NBodySimulation::getParticles() const {
+    std::vector<ECE_ChargedParticle> particles;
+    particles.reserve(state.size());
+    for (size_t i = 0; i < state.size(); ++i) {
+        particles.emplace_back(state.x[i], state.y[i], state.z[i], state.q[i] * 1e6, mass[i]);
+        particles.back().setVelocity(vx[i], vy[i], vz[i]);
+    }
+    return particles;
+}
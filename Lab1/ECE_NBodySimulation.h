@@ -0,0 +1,75 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Contains the electrostatic N-body integrator (velocity Verlet) and the binary trajectory writer.
+*/
+
+#pragma once
+
+#include <vector>
+#include <fstream>
+#include <string>
+#include <cstdint>
+
+#include "ECE_ChargedParticle.h"
+#include "ECE_CoulombInteractions.h"
+
+// Writes periodic snapshots to a compact binary trajectory file.
+// Layout (little endian): "ECETRAJ1", uint64 numParticles, then per snapshot
+// uint64 step, double time, float x[numParticles], float y[numParticles], float z[numParticles].
+class ECE_TrajectoryWriter {
+public:
+    // Open the trajectory file and write its header.
+    ECE_TrajectoryWriter(const std::string& path, size_t numParticles);
+
+    // Check if the file was opened successfully.
+    bool isOpen() const;
+
+    // Append one snapshot of the particle positions.
+    void writeSnapshot(uint64_t step, double time, const ChargeArrays& state);
+
+private:
+    std::ofstream file;
+    std::vector<float> buffer;  // Reused single-precision staging buffer
+};
+
+class ECE_NBodySimulation {
+public:
+    // Constructor to copy the particles into SoA state and evaluate the initial forces.
+    // A positive cutoff (m) switches to the cell-list evaluator with shifted-force Coulomb interactions.
+    ECE_NBodySimulation(const std::vector<ECE_ChargedParticle>& particles, int numThreads, double cutoff);
+
+    // Advance the system by one velocity-Verlet step of dt seconds.
+    void step(double dt);
+
+    // Kinetic energy of the particles in J.
+    double getKineticEnergy() const;
+
+    // Electrostatic potential energy of the current configuration in J.
+    double getPotentialEnergy() const;
+
+    // Number of steps taken and the simulated time in seconds.
+    uint64_t getStepCount() const;
+    double getTime() const;
+
+    // Current particle positions and charges.
+    const ChargeArrays& getState() const;
+
+    // Copy the current state back into particle objects.
+    std::vector<ECE_ChargedParticle> getParticles() const;
+
+private:
+    // Evaluate forces and potential energy for the current positions.
+    void computeForces();
+
+    ChargeArrays state;
+    std::vector<double> vx, vy, vz;
+    std::vector<double> mass;
+    std::vector<double> invMass;
+    CoulombResult forces;
+    int numThreads;
+    double cutoff;
+    uint64_t stepCount;
+    double time;
+};
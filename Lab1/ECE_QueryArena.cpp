@@ -0,0 +1,91 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Contains the monotonic arena used for per-query temporaries in the field drivers.
+*/
+
+#include "ECE_QueryArena.h"
+#include <cstdint>
+#include <new>
+
+// Constructor to reserve the initial arena block.
+ECE_QueryArena::ECE_QueryArena(size_t initialCapacity)
+    : offset(0), bytesUsed(0), heapAllocations(0) {
+    addBlock(initialCapacity > 0 ? initialCapacity : 1);
+}
+
+// Destructor to release every arena block.
+ECE_QueryArena::~ECE_QueryArena() {
+    for (const auto& block : blocks) {
+        ::operator delete(block.data);
+    }
+}
+
+// Reserve a new block of at least the given size and make it current.
+void ECE_QueryArena::addBlock(size_t size) {
+    Block block;
+    block.data = static_cast<char*>(::operator new(size));
+    block.size = size;
+    blocks.push_back(block);
+    offset = 0;
+    ++heapAllocations;
+}
+
+// Allocate a block of memory with the requested alignment.
+void* ECE_QueryArena::allocate(size_t bytes, size_t alignment) {
+    Block* current = &blocks.back();
+    uintptr_t base = reinterpret_cast<uintptr_t>(current->data);
+    size_t aligned = ((base + offset + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+
+    if (aligned + bytes > current->size) {
+        // Grow geometrically so a query only overflows a handful of times
+        size_t size = current->size * 2;
+        if (size < bytes + alignment) {
+            size = bytes + alignment;
+        }
+        addBlock(size);
+        current = &blocks.back();
+        base = reinterpret_cast<uintptr_t>(current->data);
+        aligned = ((base + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+    }
+
+    offset = aligned + bytes;
+    bytesUsed += bytes;
+    return current->data + aligned;
+}
+
+// Release everything allocated since the last reset.
+void ECE_QueryArena::reset() {
+    if (blocks.size() > 1) {
+        // Replace the overflow chain with one block large enough for the whole query
+        size_t total = 0;
+        for (const auto& block : blocks) {
+            total += block.size;
+            ::operator delete(block.data);
+        }
+        blocks.clear();
+        addBlock(total);
+    }
+    offset = 0;
+    bytesUsed = 0;
+}
+
+// Bytes handed out since the last reset.
+size_t ECE_QueryArena::getBytesUsed() const {
+    return bytesUsed;
+}
+
+// Total bytes currently reserved by the arena.
+size_t ECE_QueryArena::getCapacity() const {
+    size_t total = 0;
+    for (const auto& block : blocks) {
+        total += block.size;
+    }
+    return total;
+}
+
+// Number of times the arena has had to go to the heap.
+size_t ECE_QueryArena::getHeapAllocations() const {
+    return heapAllocations;
+}
@@ -0,0 +1,94 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Monotonic arena that backs the per-query temporaries of the field drivers. Memory is handed out
+by bumping an offset and is only released as a whole by reset(), so once the arena has grown to the size of
+a query no further heap allocations are made.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+class ECE_QueryArena {
+public:
+    // Constructor to reserve the initial arena block.
+    explicit ECE_QueryArena(size_t initialCapacity = 1 << 20);
+
+    // Destructor to release every arena block.
+    ~ECE_QueryArena();
+
+    ECE_QueryArena(const ECE_QueryArena&) = delete;
+    ECE_QueryArena& operator=(const ECE_QueryArena&) = delete;
+
+    // Allocate a block of memory with the requested alignment.
+    void* allocate(size_t bytes, size_t alignment);
+
+    // Release everything allocated since the last reset. Overflow blocks are merged so the next query fits in one block.
+    void reset();
+
+    // Bytes handed out since the last reset.
+    size_t getBytesUsed() const;
+
+    // Total bytes currently reserved by the arena.
+    size_t getCapacity() const;
+
+    // Number of times the arena has had to go to the heap.
+    size_t getHeapAllocations() const;
+
+private:
+    struct Block {
+        char* data;
+        size_t size;
+    };
+
+    // Reserve a new block of at least the given size and make it current.
+    void addBlock(size_t size);
+
+    std::vector<Block> blocks;  // Current block is blocks.back()
+    size_t offset;              // Offset of the next free byte in the current block
+    size_t bytesUsed;
+    size_t heapAllocations;
+};
+
+// Standard allocator adaptor so std::vector and friends can draw from an ECE_QueryArena.
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(ECE_QueryArena& arena) : arena(&arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.getArena()) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    // Memory is reclaimed by ECE_QueryArena::reset()
+    void deallocate(T*, size_t) {}
+
+    ECE_QueryArena* getArena() const {
+        return arena;
+    }
+
+private:
+    ECE_QueryArena* arena;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+    return a.getArena() == b.getArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+    return !(a == b);
+}
+
+// Vector whose storage lives in an ECE_QueryArena
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
@@ -0,0 +1,106 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Driver for the periodic solvers. The N x M charge grid is treated as the unit cell of an infinite
+lattice (repeated every Lz along z); the energy per cell and the field at a point are computed with Ewald
+summation and with particle-mesh Ewald.
+*/
+
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#include "ECE_ElectricFieldUtils.h"
+#include "ECE_Ewald.h"
+
+// Function to validate the cell height (> 0) and the relative tolerance (0 < tolerance < 0.1)
+bool validateCellSettings(const std::vector<double>& values) {
+    return values.size() == 2 && values[0] > 0.0 && values[1] > 0.0 && values[1] < 0.1;
+}
+
+int main() {
+    bool continueCalculations = true;
+    int numThreads = std::thread::hardware_concurrency();
+
+    std::vector<int> gridDim;
+    std::vector<double> separationDist;
+    std::vector<double> charges;
+    std::vector<double> cellSettings;
+    std::vector<double> electricFieldPoint;
+
+    while (continueCalculations) {
+        std::cout << "Your computer supports " << numThreads << " concurrent threads" << std::endl;
+
+        getInput<int>("Please enter the number of rows and columns in the N x M array: ", gridDim, 2, "Grid Dimensions should be natural numbers!", validateBounds);
+        getInput<double>("Please enter the x and y separation distances in meters: ", separationDist, 2, "(N x M) separation distance values must be > 0!", validateBounds);
+        getInput<double>("Please enter the common charge on the points in micro C: ", charges, 1, "Point Charge value should be > 0.0!", validateBounds);
+        getInput<double>("Please enter the cell height along z in meters and the relative tolerance: ", cellSettings, 2, "Cell height should be > 0 and the tolerance between 0 and 0.1!", validateCellSettings);
+
+        int N = gridDim[0];
+        int M = gridDim[1];
+        auto grid = calculateGridCoordinates(N, M, separationDist[0], separationDist[1]);
+        getInput<double>("Please enter the location in space to determine the electric field (x y z) in meters: ", electricFieldPoint, 3, "Overlap detected with the user-provided electric field point.", validateOverlap, grid);
+        Point3D probe = {electricFieldPoint[0], electricFieldPoint[1], electricFieldPoint[2]};
+
+        std::vector<ECE_PointCharge> pointCharges;
+        for (const auto& point : grid) {
+            pointCharges.emplace_back(point.x, point.y, point.z, charges[0]);
+        }
+        ChargeArrays packed = packCharges(pointCharges);
+        PeriodicCell cell = makeLatticeCell(N, M, separationDist[0], separationDist[1], cellSettings[0]);
+
+        // Refuse setups whose mesh or k-vector box would not fit in memory before building anything
+        double tolerance = cellSettings[1];
+        EwaldParameters planned = chooseEwaldParameters(cell, packed.size(), tolerance);
+        if (meshPointCount(planned) > MAX_MESH_POINTS || kVectorBound(planned) > MAX_K_VECTORS) {
+            std::cout << "[ERROR] This cell would need a " << planned.mesh[0] << " x " << planned.mesh[1] << " x " << planned.mesh[2]
+                      << " PME mesh and up to " << kVectorBound(planned) << " k-vectors; use a looser tolerance or a cell height"
+                      << " closer to the grid spacing." << std::endl;
+        } else {
+            auto start = std::chrono::high_resolution_clock::now();
+            ECE_Ewald ewald(packed, cell, tolerance, numThreads);
+            auto setup = std::chrono::high_resolution_clock::now();
+
+            const EwaldParameters& params = ewald.getParameters();
+            std::cout << "alpha = " << params.alpha << " 1/m, real-space cutoff = " << params.realCutoff << " m, PME mesh = "
+                      << params.mesh[0] << " x " << params.mesh[1] << " x " << params.mesh[2] << std::endl;
+            std::cout << "Relative accuracy: Ewald " << tolerance << ", PME about " << params.meshTolerance
+                      << (params.meshTolerance > tolerance ? " (mesh limited by its size)" : "") << std::endl;
+
+            int precision = 4;
+            for (bool useMesh : {false, true}) {
+                auto begin = std::chrono::high_resolution_clock::now();
+                double energy = ewald.computeEnergy(useMesh);
+                FieldSample field = ewald.computeFieldAt(probe, useMesh);
+                auto end = std::chrono::high_resolution_clock::now();
+
+                std::cout << (useMesh ? "Particle-mesh Ewald:" : "Ewald summation:") << std::endl;
+                printScientificNotation("    U per cell", energy, precision);
+                printScientificNotation("    Ex", field.Ex, precision);
+                printScientificNotation("    Ey", field.Ey, precision);
+                printScientificNotation("    Ez", field.Ez, precision);
+                printScientificNotation("    |E|", std::sqrt(field.Ex * field.Ex + field.Ey * field.Ey + field.Ez * field.Ez), precision);
+                std::cout << "    The calculation took " << std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count() << " microseconds!" << std::endl;
+            }
+            std::cout << "Setup (structure factors and mesh) took "
+                      << std::chrono::duration_cast<std::chrono::microseconds>(setup - start).count() << " microseconds!" << std::endl;
+        }
+
+        char continueChoice;
+        std::cout << "Do you want to enter a new configuration (Y/N)? ";
+        std::cin >> continueChoice;
+
+        // Clear any remaining characters in the input buffer
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+        if (continueChoice != 'Y' && continueChoice != 'y') {
+            continueCalculations = false;
+        }
+    }
+
+    return 0;
+}
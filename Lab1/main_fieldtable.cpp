@@ -0,0 +1,140 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Driver for the precomputed field table. Builds the table for a charge grid over a region, saves it,
+memory-maps it back, measures lookup throughput and answers probe queries with their error estimate.
+*/
+
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <limits>
+
+#include "ECE_ElectricField.h"
+#include "ECE_ElectricFieldUtils.h"
+#include "ECE_FieldTable.h"
+
+// Function to validate that the region is given as (xmin ymin zmin xmax ymax zmax) with max > min
+bool validateRegion(const std::vector<double>& values)
+{
+    return values[3] > values[0] && values[4] > values[1] && values[5] > values[2];
+}
+
+int main() {
+    int numThreads = std::thread::hardware_concurrency();
+    std::cout << "Your computer supports " << numThreads << " concurrent threads" << std::endl;
+
+    std::vector<int> gridDim;
+    getInput<int>("Please enter the number of rows and columns in the N x M array: ", gridDim, 2, "Grid Dimensions should be natural numbers!", validateBounds);
+
+    std::vector<double> separationDist;
+    getInput<double>("Please enter the x and y separation distances in meters: ", separationDist, 2, "(N x M) separation distance values must be > 0!", validateBounds);
+
+    std::vector<double> charges;
+    getInput<double>("Please enter the common charge on the points in micro C: ", charges, 1, "Point Charge value should be > 0.0!", validateBounds);
+
+    std::vector<double> region;
+    getInput<double>("Please enter the table region (xmin ymin zmin xmax ymax zmax) in meters: ", region, 6, "Region maximum should be larger than its minimum!", validateRegion);
+
+    std::vector<double> tableSettings;
+    getInput<double>("Please enter the relative tolerance and the maximum octree depth: ", tableSettings, 2, "Tolerance and depth should be > 0!", validateBounds);
+
+    std::cout << "Please enter the table file name [field_table.bin]: ";
+    std::string path;
+    std::getline(std::cin, path);
+    if (path.empty()) {
+        path = "field_table.bin";
+    }
+
+    auto grid = calculateGridCoordinates(gridDim[0], gridDim[1], separationDist[0], separationDist[1]);
+    std::vector<ECE_ElectricField> electricFields;
+    electricFields.reserve(grid.size());
+    for (const auto& point : grid) {
+        electricFields.emplace_back(point.x, point.y, point.z, charges[0]);
+    }
+    ChargeArrays packed = packCharges(electricFields);
+
+    Point3D lower = {region[0], region[1], region[2]};
+    Point3D upper = {region[3], region[4], region[5]};
+
+    auto start = std::chrono::high_resolution_clock::now();
+    {
+        ECE_FieldTable table(packed, lower, upper, tableSettings[0], static_cast<int>(tableSettings[1]), numThreads);
+        auto built = std::chrono::high_resolution_clock::now();
+        std::cout << "Built " << table.getNumLeaves() << " patches (" << table.getNumNodes() << " nodes) in "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(built - start).count() << " ms" << std::endl;
+        if (!table.save(path)) {
+            std::cerr << "[ERROR] Could not write " << path << std::endl;
+            return 1;
+        }
+    }
+
+    ECE_FieldTable table(path);
+    if (!table.isValid()) {
+        std::cerr << "[ERROR] Could not map " << path << std::endl;
+        return 1;
+    }
+
+    // Throughput over random points in the region
+    const int numLookups = 1000000;
+    std::mt19937 generator(12345);
+    std::uniform_real_distribution<double> ux(lower.x, upper.x), uy(lower.y, upper.y), uz(lower.z, upper.z);
+    std::vector<Point3D> queries(numLookups);
+    for (auto& query : queries) {
+        query = {ux(generator), uy(generator), uz(generator)};
+    }
+    double checksum = 0.0, worstEstimate = 0.0;
+    auto lookupStart = std::chrono::high_resolution_clock::now();
+    for (const auto& query : queries) {
+        FieldTableSample sample = table.lookup(query);
+        checksum += sample.Ex;
+        worstEstimate = std::max(worstEstimate, sample.errorEstimate);
+    }
+    auto lookupStop = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(lookupStop - lookupStart).count();
+    std::cout << "Single-thread lookups per second: " << static_cast<long long>(numLookups / seconds)
+              << " (largest patch error estimate " << worstEstimate << ", checksum " << checksum << ")" << std::endl;
+
+    bool continueCalculations = true;
+    std::vector<double> electricFieldPoint;
+    while (continueCalculations) {
+        getInput<double>("Please enter the location in space to determine the electric field (x y z) in meters: ", electricFieldPoint, 3, "Overlap detected with the user-provided electric field point.", validateOverlap, grid);
+        Point3D probe = {electricFieldPoint[0], electricFieldPoint[1], electricFieldPoint[2]};
+
+        FieldTableSample sample = table.lookup(probe);
+        if (!sample.inside) {
+            std::cout << "[ERROR] The point is outside the table region." << std::endl;
+        } else {
+            double Ex = 0.0, Ey = 0.0, Ez = 0.0;
+            for (const auto& electricField : electricFields) {
+                electricField.addFieldAt(probe.x, probe.y, probe.z, Ex, Ey, Ez);
+            }
+
+            int precision = 4;
+            printScientificNotation("Ex", sample.Ex, precision);
+            printScientificNotation("Ey", sample.Ey, precision);
+            printScientificNotation("Ez", sample.Ez, precision);
+            printScientificNotation("Error estimate", sample.errorEstimate, precision);
+            double dx = sample.Ex - Ex, dy = sample.Ey - Ey, dz = sample.Ez - Ez;
+            printScientificNotation("Actual relative error", std::sqrt((dx * dx + dy * dy + dz * dz) / (Ex * Ex + Ey * Ey + Ez * Ez)), precision);
+        }
+
+        char continueChoice;
+        std::cout << "Do you want to enter a new location (Y/N)? ";
+        std::cin >> continueChoice;
+
+        // Clear any remaining characters in the input buffer
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+        if (continueChoice != 'Y' && continueChoice != 'y') {
+            continueCalculations = false;
+        }
+    }
+
+    return 0;
+}
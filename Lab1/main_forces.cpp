@@ -0,0 +1,130 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Driver for the all-pairs Coulomb engine. Prompts for the charge grid, computes the net force on
+every charge and the total electrostatic potential energy of the configuration. With a cutoff radius the
+cell-list evaluator is used instead, and its batched field probes are checked against a scan of all charges.
+*/
+
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <algorithm>
+
+#include "ECE_ElectricField.h"
+#include "ECE_ElectricFieldUtils.h"
+#include "ECE_CoulombInteractions.h"
+#include "ECE_CellList.h"
+
+int main() {
+    bool continueCalculations = true;
+    int numThreads = std::thread::hardware_concurrency();
+
+    std::vector<int> gridDim;
+    std::vector<double> separationDist;
+    std::vector<double> charges;
+    std::vector<double> cutoffSettings;
+
+    while (continueCalculations) {
+        std::cout << "Your computer supports " << numThreads << " concurrent threads" << std::endl;
+
+        getInput<int>("Please enter the number of rows and columns in the N x M array: ", gridDim, 2, "Grid Dimensions should be natural numbers!", validateBounds);
+        int N = gridDim[0];
+        int M = gridDim[1];
+
+        getInput<double>("Please enter the x and y separation distances in meters: ", separationDist, 2, "(N x M) separation distance values must be > 0!", validateBounds);
+        double xSeparation = separationDist[0];
+        double ySeparation = separationDist[1];
+
+        getInput<double>("Please enter the common charge on the points in micro C: ", charges, 1, "Point Charge value should be > 0.0!", validateBounds);
+        double chargeVal = charges[0];
+
+        getInput<double>("Please enter the cutoff radius in meters (0 for all pairs) and the tail mode (0 truncated, 1 shifted force): ", cutoffSettings, 2, "Cutoff radius and tail mode should be >= 0!", validateNonNegative);
+        double cutoff = cutoffSettings[0];
+        bool shiftedForce = cutoffSettings[1] != 0.0;
+
+        auto grid = calculateGridCoordinates(N, M, xSeparation, ySeparation);
+        std::vector<ECE_PointCharge> pointCharges;
+        pointCharges.reserve(grid.size());
+        for (const auto& point : grid) {
+            pointCharges.emplace_back(point.x, point.y, point.z, chargeVal);
+        }
+        ChargeArrays packed = packCharges(pointCharges);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        CoulombResult result;
+        std::unique_ptr<ECE_CellList> cells;
+        if (cutoff > 0.0) {
+            cells.reset(new ECE_CellList(packed, cutoff, shiftedForce));
+            result = cells->computeInteractions(numThreads);
+        } else {
+            result = computeCoulombInteractions(packed, numThreads);
+        }
+        auto stop = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+
+        // Probe the field midway between neighbouring charges, just above the plane, and compare the batched
+        // cell-list field with a scan of every charge under the same cutoff
+        long long probeMicroseconds = 0;
+        double probeDeviation = 0.0;
+        std::vector<Point3D> probes;
+        if (cells) {
+            double lift = 0.5 * std::min(xSeparation, ySeparation);
+            probes.reserve(grid.size());
+            for (const auto& point : grid) {
+                probes.push_back(Point3D{point.x + 0.5 * xSeparation, point.y - 0.5 * ySeparation, lift});
+            }
+            auto probeStart = std::chrono::high_resolution_clock::now();
+            std::vector<FieldSample> fields = cells->computeFieldAt(probes, numThreads);
+            auto probeStop = std::chrono::high_resolution_clock::now();
+            probeMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(probeStop - probeStart).count();
+
+            double largestField = 0.0, largestDifference = 0.0;
+            for (size_t p = 0; p < probes.size(); ++p) {
+                FieldSample reference = cells->computeFieldDirect(probes[p]);
+                double dEx = fields[p].Ex - reference.Ex, dEy = fields[p].Ey - reference.Ey, dEz = fields[p].Ez - reference.Ez;
+                largestField = std::max(largestField, std::sqrt(reference.Ex * reference.Ex + reference.Ey * reference.Ey + reference.Ez * reference.Ez));
+                largestDifference = std::max(largestDifference, std::sqrt(dEx * dEx + dEy * dEy + dEz * dEz));
+            }
+            probeDeviation = (largestField > 0.0) ? largestDifference / largestField : largestDifference;
+        }
+
+        // Largest net force and the residual of the total force (zero by Newton's third law)
+        double maxForce = 0.0;
+        double totalFx = 0.0, totalFy = 0.0, totalFz = 0.0;
+        for (size_t i = 0; i < packed.size(); ++i) {
+            maxForce = std::max(maxForce, std::sqrt(result.Fx[i] * result.Fx[i] + result.Fy[i] * result.Fy[i] + result.Fz[i] * result.Fz[i]));
+            totalFx += result.Fx[i];
+            totalFy += result.Fy[i];
+            totalFz += result.Fz[i];
+        }
+
+        int precision = 4;
+        printScientificNotation("U", result.potentialEnergy, precision);
+        printScientificNotation("max |F|", maxForce, precision);
+        printScientificNotation("|sum F|", std::sqrt(totalFx * totalFx + totalFy * totalFy + totalFz * totalFz), precision);
+        std::cout << "The calculation took " << duration.count() << " microseconds!" << std::endl;
+        if (cells) {
+            std::cout << "Cell-list field at " << probes.size() << " probes took " << probeMicroseconds << " microseconds; ";
+            printScientificNotation("deviation from all charges", probeDeviation, precision);
+        }
+
+        char continueChoice;
+        std::cout << "Do you want to enter a new configuration (Y/N)? ";
+        std::cin >> continueChoice;
+
+        // Clear any remaining characters in the input buffer
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+        if (continueChoice != 'Y' && continueChoice != 'y') {
+            continueCalculations = false;
+        }
+    }
+
+    return 0;
+}
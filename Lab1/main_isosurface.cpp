@@ -0,0 +1,117 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Driver for the equipotential-surface extraction. Samples the potential of a charge grid on a
+lattice over a region and writes one OBJ mesh per requested iso-potential level, ready for loadOBJ.
+*/
+
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <limits>
+
+#include "ECE_ElectricField.h"
+#include "ECE_ElectricFieldUtils.h"
+#include "ECE_IsoSurface.h"
+
+// Function to validate that the region is given as (xmin ymin zmin xmax ymax zmax) with max > min
+bool validateRegion(const std::vector<double>& values)
+{
+    return values[3] > values[0] && values[4] > values[1] && values[5] > values[2];
+}
+
+// Function to validate the lattice resolution (at least two points per axis)
+bool validateResolution(const std::vector<int>& values)
+{
+    return values[0] >= 2 && values[1] >= 2 && values[2] >= 2;
+}
+
+// Function to validate the level range (first, last, count) with a whole number of levels
+bool validateLevels(const std::vector<double>& values)
+{
+    return values[0] > 0 && values[1] >= values[0] && values[2] >= 1 && values[2] == static_cast<int>(values[2]);
+}
+
+int main() {
+    int numThreads = std::thread::hardware_concurrency();
+    std::cout << "Your computer supports " << numThreads << " concurrent threads" << std::endl;
+
+    std::vector<int> gridDim;
+    getInput<int>("Please enter the number of rows and columns in the N x M array: ", gridDim, 2, "Grid Dimensions should be natural numbers!", validateBounds);
+
+    std::vector<double> separationDist;
+    getInput<double>("Please enter the x and y separation distances in meters: ", separationDist, 2, "(N x M) separation distance values must be > 0!", validateBounds);
+
+    std::vector<double> charges;
+    getInput<double>("Please enter the common charge on the points in micro C: ", charges, 1, "Point Charge value should be > 0.0!", validateBounds);
+
+    std::vector<double> region;
+    getInput<double>("Please enter the lattice region (xmin ymin zmin xmax ymax zmax) in meters: ", region, 6, "Region maximum should be larger than its minimum!", validateRegion);
+
+    std::vector<int> resolution;
+    getInput<int>("Please enter the number of lattice points along x, y and z: ", resolution, 3, "Each axis needs at least 2 lattice points!", validateResolution);
+
+    std::vector<double> levels;
+    getInput<double>("Please enter the first and last potential in volts and the number of levels: ", levels, 3, "Levels should be > 0, last >= first, and the count a natural number!", validateLevels);
+
+    std::cout << "Please enter the output file prefix [equipotential]: ";
+    std::string prefix;
+    std::getline(std::cin, prefix);
+    if (prefix.empty()) {
+        prefix = "equipotential";
+    }
+
+    auto grid = calculateGridCoordinates(gridDim[0], gridDim[1], separationDist[0], separationDist[1]);
+    std::vector<ECE_ElectricField> electricFields;
+    electricFields.reserve(grid.size());
+    for (const auto& point : grid) {
+        electricFields.emplace_back(point.x, point.y, point.z, charges[0]);
+    }
+    ChargeArrays packed = packCharges(electricFields);
+
+    LatticeSpec spec;
+    spec.lower = Point3D{region[0], region[1], region[2]};
+    spec.upper = Point3D{region[3], region[4], region[5]};
+    spec.nx = resolution[0];
+    spec.ny = resolution[1];
+    spec.nz = resolution[2];
+
+    auto start = std::chrono::high_resolution_clock::now();
+    ECE_PotentialLattice lattice(packed, spec, numThreads);
+    auto sampled = std::chrono::high_resolution_clock::now();
+    std::cout << "Sampled the potential in " << std::chrono::duration_cast<std::chrono::milliseconds>(sampled - start).count() << " ms" << std::endl;
+
+    double minPotential, maxPotential;
+    lattice.getRange(minPotential, maxPotential);
+    int precision = 4;
+    printScientificNotation("Potential min", minPotential, precision);
+    printScientificNotation("Potential max", maxPotential, precision);
+
+    int numLevels = static_cast<int>(levels[2]);
+    for (int level = 0; level < numLevels; ++level) {
+        double isoLevel = (numLevels == 1) ? levels[0] : levels[0] + (levels[1] - levels[0]) * level / (numLevels - 1);
+
+        auto extractStart = std::chrono::high_resolution_clock::now();
+        IsoMesh mesh = lattice.extractIsoSurface(isoLevel, numThreads);
+        auto extractStop = std::chrono::high_resolution_clock::now();
+
+        std::string path = prefix + "_" + std::to_string(level) + ".obj";
+        if (!writeOBJ(mesh, path)) {
+            std::cerr << "[ERROR] Could not write " << path << std::endl;
+            return 1;
+        }
+
+        printScientificNotation("Level", isoLevel, precision);
+        std::cout << "  " << mesh.vertices.size() << " vertices, " << mesh.indices.size() / 3 << " triangles in "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(extractStop - extractStart).count() << " ms -> " << path << std::endl;
+        if (mesh.vertices.size() > std::numeric_limits<unsigned short>::max()) {
+            // indexVBO in Final_Project/common stores 16-bit indices
+            std::cout << "  Note: more than 65535 vertices; indexVBO's 16-bit index buffer will not hold this mesh" << std::endl;
+        }
+    }
+
+    return 0;
+}
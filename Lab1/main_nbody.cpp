@@ -0,0 +1,89 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Driver for the electrostatic N-body mode. The charge grid is given mass and released from rest;
+the charges move under their mutual Coulomb forces and snapshots are written to a binary trajectory file.
+*/
+
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <limits>
+
+#include "ECE_ElectricFieldUtils.h"
+#include "ECE_NBodySimulation.h"
+
+int main() {
+    int numThreads = std::thread::hardware_concurrency();
+    std::cout << "Your computer supports " << numThreads << " concurrent threads" << std::endl;
+
+    std::vector<int> gridDim;
+    getInput<int>("Please enter the number of rows and columns in the N x M array: ", gridDim, 2, "Grid Dimensions should be natural numbers!", validateBounds);
+
+    std::vector<double> separationDist;
+    getInput<double>("Please enter the x and y separation distances in meters: ", separationDist, 2, "(N x M) separation distance values must be > 0!", validateBounds);
+
+    std::vector<double> charges;
+    getInput<double>("Please enter the common charge on the points in micro C: ", charges, 1, "Point Charge value should be > 0.0!", validateBounds);
+
+    std::vector<double> masses;
+    getInput<double>("Please enter the common mass of the points in kg: ", masses, 1, "Mass should be > 0.0!", validateBounds);
+
+    std::vector<double> timeStep;
+    getInput<double>("Please enter the time step in seconds: ", timeStep, 1, "Time step should be > 0.0!", validateBounds);
+
+    std::vector<int> stepCounts;
+    getInput<int>("Please enter the number of steps and the snapshot interval: ", stepCounts, 2, "Step counts should be natural numbers!", validateBounds);
+
+    std::vector<double> cutoffs;
+    getInput<double>("Please enter the cutoff radius in meters (0 for all pairs): ", cutoffs, 1, "Cutoff radius should be >= 0.0!", validateNonNegative);
+
+    std::cout << "Please enter the trajectory file name [trajectory.bin]: ";
+    std::string path;
+    std::getline(std::cin, path);
+    if (path.empty()) {
+        path = "trajectory.bin";
+    }
+
+    auto grid = calculateGridCoordinates(gridDim[0], gridDim[1], separationDist[0], separationDist[1]);
+    std::vector<ECE_ChargedParticle> particles;
+    particles.reserve(grid.size());
+    for (const auto& point : grid) {
+        particles.emplace_back(point.x, point.y, point.z, charges[0], masses[0]);
+    }
+
+    ECE_NBodySimulation simulation(particles, numThreads, cutoffs[0]);
+    ECE_TrajectoryWriter writer(path, particles.size());
+    if (!writer.isOpen()) {
+        std::cerr << "[ERROR] Could not open " << path << std::endl;
+        return 1;
+    }
+
+    double initialEnergy = simulation.getKineticEnergy() + simulation.getPotentialEnergy();
+    writer.writeSnapshot(simulation.getStepCount(), simulation.getTime(), simulation.getState());
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int step = 1; step <= stepCounts[0]; ++step) {
+        simulation.step(timeStep[0]);
+        if (step % stepCounts[1] == 0) {
+            writer.writeSnapshot(simulation.getStepCount(), simulation.getTime(), simulation.getState());
+        }
+    }
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+
+    double kinetic = simulation.getKineticEnergy();
+    double potential = simulation.getPotentialEnergy();
+
+    int precision = 4;
+    printScientificNotation("KE", kinetic, precision);
+    printScientificNotation("PE", potential, precision);
+    printScientificNotation("Relative energy drift", (kinetic + potential - initialEnergy) / initialEnergy, precision);
+    std::cout << "The simulation took " << duration.count() << " microseconds ("
+              << duration.count() / stepCounts[0] << " per step)!" << std::endl;
+
+    return 0;
+}
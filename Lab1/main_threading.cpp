@@ -17,11 +17,12 @@ Description: Contains the driver code. Prompts the user to enter inputs, calcula
 #include "ECE_ElectricField.h"
 #include "ECE_PointCharge.h"
 #include "ECE_ElectricFieldUtils.h"
+#include "ECE_QueryArena.h"
 
 
 std::mutex mtx;
 // Function to calculate electric fields in parallel for a range of points
-void calculateElectricFields(int threadIndex, std::vector<ECE_ElectricField> electricFields, Point3D eFieldPoint, int startIdx, int endIdx, std::vector<ThreadResult>& partialResult) {
+void calculateElectricFields(int threadIndex, ArenaVector<ECE_ElectricField>& electricFields, Point3D eFieldPoint, int startIdx, int endIdx, ArenaVector<ThreadResult>& partialResult) {
     for (int i = startIdx; i < endIdx; ++i) {
         electricFields[i].computeFieldAt(eFieldPoint.x, eFieldPoint.y, eFieldPoint.z);
         double Ex, Ey, Ez;
@@ -35,41 +36,48 @@ void calculateElectricFields(int threadIndex, std::vector<ECE_ElectricField> ele
 int main() {
     bool continueCalculations = true;
     int numThreads = std::thread::hardware_concurrency();
+
+    // Per-query temporaries are drawn from the arena, which is reset at the start of every round
+    ECE_QueryArena arena;
+    std::vector<int> gridDim;
+    std::vector<double> separationDist;
+    std::vector<double> charges;
+    std::vector<double> electricFieldPoint;
+
     while (continueCalculations) {
-        
+        arena.reset();
+        size_t heapBlocksBefore = arena.getHeapAllocations();
 
         std::cout << "Your computer supports " << numThreads << " concurrent threads" << std::endl;
        
 
         int N, M;
-        std::vector<int> gridDim;
         getInput<int>("Please enter the number of rows and columns in the N x M array: ", gridDim, 2, "Grid Dimensions should be natural numbers!", validateBounds);
         N = gridDim[0];
         M = gridDim[1];
 
         double xSeparation, ySeparation;
-        std::vector<double> separationDist;
         getInput<double>("Please enter the x and y separation distances in meters: ", separationDist, 2, "(N x M) separation distance values must be > 0!", validateBounds);
         xSeparation = separationDist[0];
         ySeparation = separationDist[1];
 
         double chargeVal;
-        std::vector<double> charges;
         getInput<double>("Please enter the common charge on the points in micro C: ", charges, 1, "Point Charge value should be > 0.0!", validateBounds);
         chargeVal = charges[0];
 
-        auto grid = calculateGridCoordinates(N, M, xSeparation, ySeparation);
+        ArenaVector<Point3D> grid{ArenaAllocator<Point3D>(arena)};
+        fillGridCoordinates(N, M, xSeparation, ySeparation, grid);
         //printGrid(grid , N , M);
-        auto threadRanges = calculateDataDistribution(N*M , numThreads);
+        ArenaVector<ThreadRange> threadRanges{ArenaAllocator<ThreadRange>(arena)};
+        fillDataDistribution(N*M , numThreads, threadRanges);
 
         Point3D eFieldPoint;
-        std::vector<double> electricFieldPoint;
 
         // Calculate data distribution for threads
-        std::vector<ECE_ElectricField> electricFields;
+        ArenaVector<ECE_ElectricField> electricFields{ArenaAllocator<ECE_ElectricField>(arena)};
+        electricFields.reserve(grid.size());
         for (const auto& point : grid) {
-            ECE_ElectricField electricField(point.x, point.y, point.z, chargeVal);
-            electricFields.push_back(electricField);
+            electricFields.emplace_back(point.x, point.y, point.z, chargeVal);
         }
 
         getInput<double>("Please enter the location in space to determine the electric field (x y z) in meters: ", electricFieldPoint, 3, "Overlap detected with the user-provided electric field point.", validateOverlap, grid);
@@ -79,11 +87,11 @@ int main() {
 
         auto start = std::chrono::high_resolution_clock::now();
         // Create and run threads
-        std::vector<std::thread> threads(threadRanges.size());
-        std::vector<ThreadResult> threadResults(threadRanges.size());
+        ArenaVector<std::thread> threads(threadRanges.size(), ArenaAllocator<std::thread>(arena));
+        ArenaVector<ThreadResult> threadResults(threadRanges.size(), ThreadResult{0.0, 0.0, 0.0}, ArenaAllocator<ThreadResult>(arena));
 
         for (int i = 0; i < threadRanges.size(); ++i) {
-            threads[i] = std::thread(calculateElectricFields, i, electricFields, eFieldPoint,
+            threads[i] = std::thread(calculateElectricFields, i, std::ref(electricFields), eFieldPoint,
                                 threadRanges[i].start, threadRanges[i].end, std::ref(threadResults));
         }
 
@@ -110,6 +118,9 @@ int main() {
         printScientificNotation("Ez", totalEz, precision);
         printScientificNotation("|E|", E, precision);
         std::cout << "The calculation took " << duration.count() << " microseconds!" << std::endl;
+        std::cout << "Query arena: " << arena.getBytesUsed() << " of " << arena.getCapacity() << " bytes used, "
+                  << arena.getHeapAllocations() - heapBlocksBefore << " new heap blocks this query ("
+                  << arena.getHeapAllocations() << " in total)" << std::endl;
 
         char continueChoice;
         std::cout << "Do you want to enter a new location (Y/N)? ";
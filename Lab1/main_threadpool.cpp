@@ -4,7 +4,9 @@ Class: ECE6122
 Last Date Modified: 24/09/2023
 Description: Creates a pool of threads which are created only once.
 Prompts the user for input and calculates grid points.
-Pushes each point into a queue and prompts the user
+Pushes each point into a queue and prompts the user.
+Run with -L for the latency mode, where the grid is handed to the workers as one broadcast
+epoch bump, workers spin briefly before parking, and completion is an atomic countdown.
 */
 
 #include <iostream>
@@ -15,15 +17,38 @@ Pushes each point into a queue and prompts the user
 #include <functional>
 #include <random>
 #include <chrono>
+#include <atomic>
+#include <string>
+#include <algorithm>
 
 #include "ECE_ElectricField.h"
 #include "ECE_PointCharge.h"
 #include "ECE_ElectricFieldUtils.h"
+#include "ECE_QueryArena.h"
+
+// Number of polls a worker makes on the broadcast epoch before parking on the condition variable
+const int SPIN_ITERATIONS = 20000;
+
+// Hint to the CPU that we are in a spin-wait loop
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+// Per-worker partial result, padded to its own cache line so workers never share one
+struct alignas(64) PaddedThreadResult {
+    double Ex;
+    double Ey;
+    double Ez;
+    double wakeupMicroseconds;  // From the epoch bump until this worker started on the broadcast
+};
 
 class ThreadPool {
 public:
-    // Constructor to initialize the thread pool with a specified number of threads.
-    ThreadPool(size_t numThreads);
+    // Constructor to initialize the thread pool with a specified number of threads. The latency mode is fixed
+    // here, before the workers start reading it.
+    ThreadPool(size_t numThreads, bool latencyMode = false);
 
     // Destructor to clean up the thread pool and join all threads.
     ~ThreadPool();
@@ -51,9 +76,22 @@ public:
     // Set the electric field point for calculation.
     void setElectricFieldPoint(const Point3D& eFieldPoint);
 
+    // Check if the latency mode is enabled.
+    bool isLatencyMode() const;
+
+    // Latency mode: hand the whole grid to the workers with one epoch bump and spin until they finish.
+    void computeBroadcast(const Point3D* points, size_t numPoints, double chargeVal);
+
+    // Largest and mean worker wake-up time of the last broadcast, in microseconds.
+    double getMaxWakeup() const;
+    double getMeanWakeup() const;
+
 private:
     // Function executed by worker threads to process tasks.
-    void workerThreadFunction();
+    void workerThreadFunction(size_t workerIndex);
+
+    // Process this worker's share of the current broadcast.
+    void processBroadcast(size_t workerIndex);
 
     // Member variables to store thread pool state and results.
     Point3D eFieldPoint;
@@ -69,24 +107,63 @@ private:
     size_t totalTasks;      // Total number of tasks
     std::mutex completionMutex;
     std::condition_variable completionCondition;
+
+    // Latency mode state. The broadcast fields are written before the epoch is bumped.
+    const bool latencyMode;
+    bool callerSpins;                         // More hardware threads than workers, so spinning is worthwhile
+    std::atomic<unsigned> epoch;              // Bumped once per broadcast
+    std::atomic<size_t> pendingWorkers;       // Workers still busy with the current broadcast
+    std::atomic<int> parkedWorkers;           // Workers blocked on taskCondition
+    const Point3D* broadcastPoints;
+    double broadcastCharge;
+    std::chrono::steady_clock::time_point broadcastStart;
+    std::vector<ThreadRange> workerRanges;
+    std::vector<PaddedThreadResult> workerResults;
 };
 
 // Constructor definition for ThreadPool class.
-ThreadPool::ThreadPool(size_t numThreads)
-    : stop(false), resultEx(0), resultEy(0), resultEz(0), eFieldPoint({0,0,0}), completedTasks(0), totalTasks(0) {
+ThreadPool::ThreadPool(size_t numThreads, bool latencyMode)
+    : stop(false), resultEx(0), resultEy(0), resultEz(0), eFieldPoint({0,0,0}), completedTasks(0), totalTasks(0),
+      latencyMode(latencyMode), epoch(0), pendingWorkers(0), parkedWorkers(0), broadcastPoints(nullptr), broadcastCharge(0),
+      workerRanges(numThreads), workerResults(numThreads) {
+    callerSpins = std::thread::hardware_concurrency() > numThreads;
     for (size_t i = 0; i < numThreads; ++i) {
-        threads.emplace_back(&ThreadPool::workerThreadFunction, this);
+        threads.emplace_back(&ThreadPool::workerThreadFunction, this, i);
     }
 }
 
 // Function executed by worker threads.
-void ThreadPool::workerThreadFunction() {
+void ThreadPool::workerThreadFunction(size_t workerIndex) {
+    unsigned seenEpoch = 0;
+
     while (true) {
         ECE_ElectricField task(0, 0, 0, 0);
 
+        // In latency mode poll the epoch for a while so a broadcast is picked up without a wakeup. With no core
+        // to spare the poll would only hold off the caller, so the worker parks at once.
+        if (latencyMode && callerSpins) {
+            for (int spin = 0; spin < SPIN_ITERATIONS; ++spin) {
+                if (epoch.load(std::memory_order_acquire) != seenEpoch) {
+                    break;
+                }
+                cpuRelax();
+            }
+        }
+
         {
             std::unique_lock<std::mutex> lock(taskMutex);
-            taskCondition.wait(lock, [this]() { return !tasks.empty() || stop; });
+            // parkedWorkers is raised before the epoch is re-checked, so computeBroadcast either
+            // sees a parked worker and notifies, or the worker sees the new epoch and does not wait
+            parkedWorkers.fetch_add(1);
+            taskCondition.wait(lock, [this, seenEpoch]() { return !tasks.empty() || stop || epoch.load() != seenEpoch; });
+            parkedWorkers.fetch_sub(1);
+
+            if (epoch.load(std::memory_order_acquire) != seenEpoch) {
+                seenEpoch = epoch.load(std::memory_order_acquire);
+                lock.unlock();
+                processBroadcast(workerIndex);
+                continue;
+            }
             if (stop && tasks.empty()) {
                 return;
             }
@@ -111,6 +188,62 @@ void ThreadPool::workerThreadFunction() {
     }
 }
 
+// Process this worker's share of the current broadcast and count it off.
+void ThreadPool::processBroadcast(size_t workerIndex) {
+    std::chrono::duration<double, std::micro> wakeup = std::chrono::steady_clock::now() - broadcastStart;
+    double Ex = 0.0, Ey = 0.0, Ez = 0.0;
+    const ThreadRange& range = workerRanges[workerIndex];
+    for (int i = range.start; i < range.end; ++i) {
+        ECE_ElectricField charge(broadcastPoints[i].x, broadcastPoints[i].y, broadcastPoints[i].z, broadcastCharge);
+        charge.addFieldAt(eFieldPoint.x, eFieldPoint.y, eFieldPoint.z, Ex, Ey, Ez);
+    }
+
+    workerResults[workerIndex].Ex = Ex;
+    workerResults[workerIndex].Ey = Ey;
+    workerResults[workerIndex].Ez = Ez;
+    workerResults[workerIndex].wakeupMicroseconds = wakeup.count();
+    pendingWorkers.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+// Latency mode: publish the grid, bump the epoch once and spin on the completion counter.
+void ThreadPool::computeBroadcast(const Point3D* points, size_t numPoints, double chargeVal) {
+    size_t numWorkers = threads.size();
+
+    // Workers beyond the number of points receive an empty range
+    for (size_t i = 0; i < numWorkers; ++i) {
+        workerRanges[i].start = static_cast<int>(numPoints * i / numWorkers);
+        workerRanges[i].end = static_cast<int>(numPoints * (i + 1) / numWorkers);
+    }
+    broadcastPoints = points;
+    broadcastCharge = chargeVal;
+    pendingWorkers.store(numWorkers, std::memory_order_relaxed);
+
+    broadcastStart = std::chrono::steady_clock::now();
+    epoch.fetch_add(1);
+    if (parkedWorkers.load() > 0) {
+        // Taking the lock guarantees a parking worker is already inside wait() when notified
+        std::lock_guard<std::mutex> lock(taskMutex);
+        taskCondition.notify_all();
+    }
+
+    // Spinning only pays off when the caller has a core to itself; otherwise it would delay the workers
+    int spins = callerSpins ? 0 : SPIN_ITERATIONS;
+    while (pendingWorkers.load(std::memory_order_acquire) != 0) {
+        if (++spins < SPIN_ITERATIONS) {
+            cpuRelax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    resultEx = resultEy = resultEz = 0.0;
+    for (const auto& result : workerResults) {
+        resultEx += result.Ex;
+        resultEy += result.Ey;
+        resultEz += result.Ez;
+    }
+}
+
 // Destructor definition for ThreadPool class.
 ThreadPool::~ThreadPool() {
     {
@@ -179,9 +312,31 @@ void ThreadPool::setElectricFieldPoint(const Point3D& eFieldPoint) {
     this->eFieldPoint = eFieldPoint;
 }
 
-int main() {
+// Largest and mean worker wake-up time of the last broadcast, in microseconds.
+double ThreadPool::getMaxWakeup() const {
+    double largest = 0.0;
+    for (const auto& result : workerResults) {
+        largest = std::max(largest, result.wakeupMicroseconds);
+    }
+    return largest;
+}
+
+double ThreadPool::getMeanWakeup() const {
+    double total = 0.0;
+    for (const auto& result : workerResults) {
+        total += result.wakeupMicroseconds;
+    }
+    return workerResults.empty() ? 0.0 : total / workerResults.size();
+}
+
+// Check if the latency mode is enabled.
+bool ThreadPool::isLatencyMode() const {
+    return latencyMode;
+}
+
+int main(int argc, char* argv[]) {
     int numThreads = std::thread::hardware_concurrency();
-    ThreadPool pool(numThreads);
+    ThreadPool pool(numThreads, argc > 1 && std::string(argv[1]) == "-L");
 
     int N = 0, M = 0;
     double xSeparation = 0.0, ySeparation = 0.0;
@@ -194,7 +349,12 @@ int main() {
     Point3D eFieldPoint;
     bool continueCalculations = true;
 
+    // Per-query temporaries are drawn from the arena, which is reset at the start of every round
+    ECE_QueryArena arena;
+
     while (continueCalculations) {
+        arena.reset();
+        size_t heapBlocksBefore = arena.getHeapAllocations();
 
         std::cout << "Your computer supports " << numThreads << " concurrent threads.\n";
 
@@ -210,7 +370,8 @@ int main() {
         getInput("Please enter the common charge on the points in micro C: ", charges, 1, "Point Charge value should be > 0.0!!", validateBounds);
         chargeVal = charges[0];
 
-        auto grid = calculateGridCoordinates(N, M, xSeparation, ySeparation);
+        ArenaVector<Point3D> grid{ArenaAllocator<Point3D>(arena)};
+        fillGridCoordinates(N, M, xSeparation, ySeparation, grid);
 
         getInput("Please enter the location in space to determine the electric field (x y z) in meters: ", electricFieldPoint, 3, "Overlap detected with the user-provided electric field point.", validateOverlap, grid);
         eFieldPoint.x = electricFieldPoint[0];
@@ -221,13 +382,18 @@ int main() {
 
         auto start = std::chrono::high_resolution_clock::now();
 
-        // Enqueue tasks for grid points and calculate electric field.
-        for (const auto& point : grid) {
-            pool.enqueueTask(point, chargeVal);
-        }
+        if (pool.isLatencyMode()) {
+            // Hand the whole grid over as a single broadcast.
+            pool.computeBroadcast(grid.data(), grid.size(), chargeVal);
+        } else {
+            // Enqueue tasks for grid points and calculate electric field.
+            for (const auto& point : grid) {
+                pool.enqueueTask(point, chargeVal);
+            }
 
-        // Wait for all tasks to complete.
-        pool.waitUntilEmpty();
+            // Wait for all tasks to complete.
+            pool.waitUntilEmpty();
+        }
 
         // Calculate total electric field magnitude.
         double totalResultEx = pool.getResultEx();
@@ -247,6 +413,13 @@ int main() {
         printScientificNotation("Ez", totalResultEz, precision);
         printScientificNotation("|E|", E, precision);
         std::cout << "The calculation took " << duration.count() << " microseconds!" << std::endl;
+        if (pool.isLatencyMode()) {
+            std::cout << "Worker wake-up after the broadcast: " << pool.getMaxWakeup() << " microseconds at most, "
+                      << pool.getMeanWakeup() << " on average" << std::endl;
+        }
+        std::cout << "Query arena: " << arena.getBytesUsed() << " of " << arena.getCapacity() << " bytes used, "
+                  << arena.getHeapAllocations() - heapBlocksBefore << " new heap blocks this query ("
+                  << arena.getHeapAllocations() << " in total)" << std::endl;
 
         char continueChoice;
         std::cout << "Do you want to enter a new location (Y/N)? ";
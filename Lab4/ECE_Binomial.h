@@ -0,0 +1,187 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Exact binomial sampling driven by Philox streams. Small means use inversion; otherwise the BTPE
+rejection algorithm of Kachitvichyanukul and Schmeiser (1988) is used, which needs O(1) expected uniforms for
+any number of trials. Only uniforms from the generator below are consumed, so draws are reproducible across
+compilers and standard libraries.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+#include "ECE_Philox.h"
+
+// Uniform doubles in [0, 1) read in order from the Philox stream (seed, stream), two per block
+class PhiloxUniform {
+public:
+    PhiloxUniform(uint64_t seed, uint64_t stream) : seed(seed), stream(stream), block(0), used(2) {}
+
+    double next() {
+        if (used == 2) {
+            bits = philoxStream(seed, stream, block++);
+            used = 0;
+        }
+        // 53 random bits from two words
+        uint64_t hi = bits.v[2 * used] >> 5;
+        uint64_t lo = bits.v[2 * used + 1] >> 6;
+        ++used;
+        return (hi * 67108864.0 + lo) * (1.0 / 9007199254740992.0);
+    }
+
+private:
+    uint64_t seed;
+    uint64_t stream;
+    uint64_t block;
+    int used;
+    PhiloxBlock bits;
+};
+
+// Inversion by sequential search from 0; expected cost O(n p), used when n * min(p, 1 - p) < 30
+inline long long binomialInversion(long long n, double p, PhiloxUniform& uniform) {
+    double q = 1.0 - p;
+    double qn = std::exp(n * std::log(q));
+    double np = n * p;
+    double bound = std::min(static_cast<double>(n), np + 10.0 * std::sqrt(np * q + 1.0));
+
+    long long x = 0;
+    double px = qn;
+    double u = uniform.next();
+    while (u > px) {
+        ++x;
+        if (x > bound) {
+            // Ran off the end of the table (round-off); restart
+            x = 0;
+            px = qn;
+            u = uniform.next();
+        } else {
+            u -= px;
+            px = ((n - x + 1) * p * px) / (x * q);
+        }
+    }
+    return x;
+}
+
+// Stirling-series correction term used in the final BTPE acceptance test
+inline double stirlingCorrection(double v) {
+    double v2 = v * v;
+    return (13680.0 - (462.0 - (132.0 - (99.0 - 140.0 / v2) / v2) / v2) / v2) / v / 166320.0;
+}
+
+// BTPE: triangle/parallelogram/exponential majorant with squeeze; valid for n * min(p, 1 - p) >= 30
+inline long long binomialBTPE(long long n, double p, PhiloxUniform& uniform) {
+    double r = std::min(p, 1.0 - p);
+    double q = 1.0 - r;
+    double fm = n * r + r;
+    long long m = static_cast<long long>(std::floor(fm));
+    double nrq = n * r * q;
+    double p1 = std::floor(2.195 * std::sqrt(nrq) - 4.6 * q) + 0.5;
+    double xm = m + 0.5;
+    double xl = xm - p1;
+    double xr = xm + p1;
+    double c = 0.134 + 20.5 / (15.3 + m);
+    double a = (fm - xl) / (fm - xl * r);
+    double laml = a * (1.0 + a / 2.0);
+    a = (xr - fm) / (xr * q);
+    double lamr = a * (1.0 + a / 2.0);
+    double p2 = p1 * (1.0 + 2.0 * c);
+    double p3 = p2 + c / laml;
+    double p4 = p3 + c / lamr;
+
+    long long y;
+    while (true) {
+        double u = uniform.next() * p4;
+        double v = uniform.next();
+
+        if (u <= p1) {
+            // Triangular region: accepted immediately
+            y = static_cast<long long>(std::floor(xm - p1 * v + u));
+            break;
+        }
+        if (u <= p2) {
+            // Parallelogram
+            double x = xl + (u - p1) / c;
+            v = v * c + 1.0 - std::fabs(m - x + 0.5) / p1;
+            if (v > 1.0) {
+                continue;
+            }
+            y = static_cast<long long>(std::floor(x));
+        } else if (u <= p3) {
+            // Left exponential tail
+            y = static_cast<long long>(std::floor(xl + std::log(v) / laml));
+            if (y < 0) {
+                continue;
+            }
+            v = v * (u - p2) * laml;
+        } else {
+            // Right exponential tail
+            y = static_cast<long long>(std::floor(xr - std::log(v) / lamr));
+            if (y > n) {
+                continue;
+            }
+            v = v * (u - p3) * lamr;
+        }
+
+        long long k = std::llabs(y - m);
+        if (k <= 20 || k >= nrq / 2.0 - 1.0) {
+            // Explicit evaluation of f(y) / f(m) by the recurrence
+            double s = r / q;
+            double aa = s * (n + 1);
+            double f = 1.0;
+            if (m < y) {
+                for (long long i = m + 1; i <= y; ++i) {
+                    f *= (aa / i - s);
+                }
+            } else if (m > y) {
+                for (long long i = y + 1; i <= m; ++i) {
+                    f /= (aa / i - s);
+                }
+            }
+            if (v <= f) {
+                break;
+            }
+            continue;
+        }
+
+        // Squeeze on log(v) before the full Stirling comparison
+        double rho = (k / nrq) * ((k * (k / 3.0 + 0.625) + 0.1666666666666667) / nrq + 0.5);
+        double t = -static_cast<double>(k) * k / (2.0 * nrq);
+        double logV = std::log(v);
+        if (logV < t - rho) {
+            break;
+        }
+        if (logV > t + rho) {
+            continue;
+        }
+
+        double x1 = y + 1.0;
+        double f1 = m + 1.0;
+        double z = n + 1.0 - m;
+        double w = n - y + 1.0;
+        double bound = xm * std::log(f1 / x1) + (n - m + 0.5) * std::log(z / w) + (y - m) * std::log(w * r / (x1 * q)) +
+                       stirlingCorrection(f1) + stirlingCorrection(z) + stirlingCorrection(x1) + stirlingCorrection(w);
+        if (logV <= bound) {
+            break;
+        }
+    }
+
+    return (p > 0.5) ? n - y : y;
+}
+
+// Binomial(n, p) variate
+inline long long sampleBinomial(long long n, double p, PhiloxUniform& uniform) {
+    if (n <= 0 || p <= 0.0) {
+        return 0;
+    }
+    if (p >= 1.0) {
+        return n;
+    }
+    if (n * std::min(p, 1.0 - p) < 30.0) {
+        return (p <= 0.5) ? binomialInversion(n, p, uniform) : n - binomialInversion(n, 1.0 - p, uniform);
+    }
+    return binomialBTPE(n, p, uniform);
+}
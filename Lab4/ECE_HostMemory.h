@@ -0,0 +1,201 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Host allocation policies for the CPU random-walk backend and its memory benchmark, the CPU
+counterparts of cudaMalloc / cudaMallocHost / cudaMallocManaged: plain heap, page-locked, demand-paged
+(first touch by whichever thread writes first), pre-faulted (MAP_POPULATE), transparent and explicit huge
+pages, and NUMA interleave. NUMA policy is set with the mbind system call directly, so no libnuma is needed.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/resource.h>
+
+#ifndef MPOL_INTERLEAVE
+#define MPOL_INTERLEAVE 3
+#endif
+
+constexpr size_t HUGE_PAGE_SIZE = 2u << 20;   // x86-64 / arm64 PMD huge page
+
+enum class HostPolicy {
+    Heap,              // malloc
+    Locked,            // mmap + mlock (pinned)
+    DemandPaged,       // mmap; pages are placed by the first thread to touch them (NUMA first touch)
+    Populated,         // mmap with MAP_POPULATE: faulted in by the allocating thread
+    TransparentHuge,   // 2 MB aligned mmap + madvise(MADV_HUGEPAGE)
+    ExplicitHuge,      // MAP_HUGETLB from the preallocated hugetlbfs pool
+    Interleaved        // mmap + mbind(MPOL_INTERLEAVE) across every NUMA node
+};
+
+const HostPolicy ALL_HOST_POLICIES[] = {HostPolicy::Heap, HostPolicy::Locked, HostPolicy::DemandPaged, HostPolicy::Populated,
+                                        HostPolicy::TransparentHuge, HostPolicy::ExplicitHuge, HostPolicy::Interleaved};
+
+inline const char* hostPolicyName(HostPolicy policy) {
+    switch (policy) {
+    case HostPolicy::Heap: return "malloc";
+    case HostPolicy::Locked: return "mmap+mlock";
+    case HostPolicy::DemandPaged: return "first-touch";
+    case HostPolicy::Populated: return "MAP_POPULATE";
+    case HostPolicy::TransparentHuge: return "THP madvise";
+    case HostPolicy::ExplicitHuge: return "MAP_HUGETLB";
+    case HostPolicy::Interleaved: return "NUMA interleave";
+    }
+    return "?";
+}
+
+// Bitmask of the NUMA nodes in /sys/devices/system/node/possible (e.g. "0-3"); node 0 if unreadable
+inline std::vector<unsigned long> numaNodeMask(unsigned long& maxNode) {
+    std::ifstream file("/sys/devices/system/node/possible");
+    std::string ranges;
+    int highest = 0;
+    std::vector<int> nodes;
+    if (file >> ranges) {
+        size_t pos = 0;
+        while (pos < ranges.size()) {
+            size_t comma = ranges.find(',', pos);
+            std::string range = ranges.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+            size_t dash = range.find('-');
+            int first = std::atoi(range.c_str());
+            int last = (dash == std::string::npos) ? first : std::atoi(range.c_str() + dash + 1);
+            for (int node = first; node <= last; ++node) {
+                nodes.push_back(node);
+            }
+            if (comma == std::string::npos) {
+                break;
+            }
+            pos = comma + 1;
+        }
+    }
+    if (nodes.empty()) {
+        nodes.push_back(0);
+    }
+    for (int node : nodes) {
+        highest = std::max(highest, node);
+    }
+
+    const int bitsPerWord = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> mask(highest / bitsPerWord + 1, 0);
+    for (int node : nodes) {
+        mask[node / bitsPerWord] |= 1ul << (node % bitsPerWord);
+    }
+    maxNode = mask.size() * bitsPerWord;
+    return mask;
+}
+
+// Page faults of the process so far
+inline void pageFaults(long& minor, long& major) {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    minor = usage.ru_minflt;
+    major = usage.ru_majflt;
+}
+
+// Owning buffer allocated under one policy
+class HostBuffer {
+public:
+    HostBuffer(HostPolicy policy, size_t bytes) : policy(policy), bytes(bytes), mapBytes(0), base(nullptr), data(nullptr), locked(false) {
+        if (bytes == 0) {
+            return;
+        }
+        switch (policy) {
+        case HostPolicy::Heap:
+            data = std::malloc(bytes);
+            break;
+        case HostPolicy::Locked:
+            mapAnonymous(bytes, 0);
+            locked = data && mlock(data, bytes) == 0;
+            if (data && !locked) {
+                note = "mlock refused (RLIMIT_MEMLOCK), not locked";
+            }
+            break;
+        case HostPolicy::DemandPaged:
+            mapAnonymous(bytes, MAP_NORESERVE);
+            break;
+        case HostPolicy::Populated:
+            mapAnonymous(bytes, MAP_POPULATE);
+            break;
+        case HostPolicy::TransparentHuge: {
+            // Over-allocate so the buffer can start on a huge page boundary
+            mapAnonymous(bytes + HUGE_PAGE_SIZE, 0);
+            if (data) {
+                uintptr_t aligned = (reinterpret_cast<uintptr_t>(base) + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+                data = reinterpret_cast<void*>(aligned);
+                if (madvise(data, bytes, MADV_HUGEPAGE) != 0) {
+                    note = "MADV_HUGEPAGE refused (THP disabled?)";
+                }
+            }
+            break;
+        }
+        case HostPolicy::ExplicitHuge: {
+            size_t rounded = (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+            mapAnonymous(rounded, MAP_HUGETLB);
+            if (!data) {
+                note = "no hugetlb pages (see /proc/sys/vm/nr_hugepages)";
+            }
+            break;
+        }
+        case HostPolicy::Interleaved: {
+            mapAnonymous(bytes, MAP_NORESERVE);
+            if (data) {
+                unsigned long maxNode;
+                std::vector<unsigned long> mask = numaNodeMask(maxNode);
+                if (syscall(SYS_mbind, data, bytes, MPOL_INTERLEAVE, mask.data(), maxNode, 0) != 0) {
+                    note = "mbind refused";
+                }
+            }
+            break;
+        }
+        }
+    }
+
+    ~HostBuffer() {
+        if (policy == HostPolicy::Heap) {
+            std::free(data);
+            return;
+        }
+        if (base) {
+            if (locked) {
+                munlock(data, bytes);
+            }
+            munmap(base, mapBytes);
+        }
+    }
+
+    HostBuffer(const HostBuffer&) = delete;
+    HostBuffer& operator=(const HostBuffer&) = delete;
+
+    void* get() const { return data; }
+    size_t size() const { return bytes; }
+    bool valid() const { return data != nullptr; }
+    const std::string& getNote() const { return note; }
+
+private:
+    void mapAnonymous(size_t size, int extraFlags) {
+        void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extraFlags, -1, 0);
+        if (mapping == MAP_FAILED) {
+            return;
+        }
+        base = mapping;
+        mapBytes = size;
+        data = mapping;
+    }
+
+    HostPolicy policy;
+    size_t bytes;
+    size_t mapBytes;
+    void* base;       // Start of the mapping (mmap policies)
+    void* data;       // Start of the usable buffer
+    bool locked;
+    std::string note; // Why the policy could not be fully applied, if it could not
+};
@@ -0,0 +1,334 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: D-dimensional lattice walks in a box of cells [-L, L]^D with obstacle and trap sites stored as
+bitsets. The walker engine is a template over the dimension, the neighbourhood and the boundary type, so every
+configuration gets its own inner loop with the move table, box test and bitset lookups resolved at compile time.
+Walkers stop as soon as they are absorbed (by a trap, or by leaving an absorbing box), which gives their
+first-passage time. Moves are drawn from Philox streams keyed on (seed, walker).
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+#include "ECE_Philox.h"
+
+// What happens to a move that would leave the box
+enum class Boundary {
+    Absorbing,    // The walker is absorbed (first exit time)
+    Reflecting    // The move is rejected and the walker stays put
+};
+
+// Nearest neighbours only: +-1 along one axis, 2D moves
+template <int D>
+struct VonNeumann {
+    static constexpr int NUM_MOVES = 2 * D;
+
+    static void delta(int move, int (&step)[D]) {
+        for (int axis = 0; axis < D; ++axis) {
+            step[axis] = 0;
+        }
+        step[move >> 1] = (move & 1) ? -1 : 1;
+    }
+};
+
+// Every cell of the surrounding 3^D cube except the centre, 3^D - 1 moves
+template <int D>
+struct Moore {
+    static constexpr int power3(int n) { return n == 0 ? 1 : 3 * power3(n - 1); }
+    static constexpr int NUM_MOVES = power3(D) - 1;
+
+    static void delta(int move, int (&step)[D]) {
+        // Skip the centre (all components zero), which sits at index (3^D - 1) / 2
+        int code = (move >= NUM_MOVES / 2) ? move + 1 : move;
+        for (int axis = 0; axis < D; ++axis) {
+            step[axis] = code % 3 - 1;
+            code /= 3;
+        }
+    }
+};
+
+// Box of (2L + 1)^D cells with obstacle (blocked) and trap (absorbing) bitsets
+class LatticeMap {
+public:
+    LatticeMap(int dimension, int halfWidth) : dimension(dimension), halfWidth(halfWidth), numCells(1) {
+        for (int axis = 0; axis < dimension; ++axis) {
+            numCells *= static_cast<uint64_t>(2 * halfWidth + 1);
+        }
+        obstacles.assign((numCells + 63) / 64, 0);
+        traps.assign((numCells + 63) / 64, 0);
+    }
+
+    // Flat index of the cell at position (each component in [-L, L])
+    uint64_t index(const int* position) const {
+        uint64_t cell = 0;
+        for (int axis = dimension - 1; axis >= 0; --axis) {
+            cell = cell * (2 * halfWidth + 1) + (position[axis] + halfWidth);
+        }
+        return cell;
+    }
+
+    bool isObstacle(uint64_t cell) const { return (obstacles[cell >> 6] >> (cell & 63)) & 1u; }
+    bool isTrap(uint64_t cell) const { return (traps[cell >> 6] >> (cell & 63)) & 1u; }
+
+    // Block each cell with probability density, except the origin; the pattern depends only on the seed
+    void addRandomObstacles(double density, uint32_t seed) {
+        uint64_t origin = centre();
+        uint64_t threshold = static_cast<uint64_t>(density * 4294967296.0);
+        for (uint64_t cell = 0; cell < numCells; ++cell) {
+            PhiloxBlock bits = philoxStream((3ull << 32) | seed, cell, 0);
+            if (cell != origin && bits.v[0] < threshold) {
+                obstacles[cell >> 6] |= 1ull << (cell & 63);
+            }
+        }
+    }
+
+    // Cells that can take a trap: neither blocked nor the origin
+    uint64_t countTrapCandidates() const {
+        uint64_t blocked = 0;
+        for (uint64_t word : obstacles) {
+            blocked += __builtin_popcountll(word);
+        }
+        return numCells - blocked - 1;
+    }
+
+    // Place count traps on free cells other than the origin; count must not exceed countTrapCandidates()
+    void addRandomTraps(int count, uint32_t seed) {
+        uint64_t origin = centre();
+        for (uint64_t draw = 0, placed = 0; placed < static_cast<uint64_t>(count) && draw < 64 * numCells; ++draw) {
+            PhiloxBlock bits = philoxStream((4ull << 32) | seed, draw, 0);
+            uint64_t cell = ((static_cast<uint64_t>(bits.v[0]) << 32) | bits.v[1]) % numCells;
+            if (cell != origin && !isObstacle(cell) && !isTrap(cell)) {
+                traps[cell >> 6] |= 1ull << (cell & 63);
+                ++placed;
+            }
+        }
+    }
+
+    int getDimension() const { return dimension; }
+    int getHalfWidth() const { return halfWidth; }
+    uint64_t getNumCells() const { return numCells; }
+
+private:
+    uint64_t centre() const {
+        uint64_t cell = 0;
+        for (int axis = 0; axis < dimension; ++axis) {
+            cell = cell * (2 * halfWidth + 1) + halfWidth;
+        }
+        return cell;
+    }
+
+    int dimension;
+    int halfWidth;
+    uint64_t numCells;
+    std::vector<uint64_t> obstacles;
+    std::vector<uint64_t> traps;
+};
+
+// 32-bit words read in order from the Philox stream (seed, stream)
+class PhiloxWords {
+public:
+    PhiloxWords(uint64_t seed, uint64_t stream) : seed(seed), stream(stream), block(0), used(4) {}
+
+    uint32_t next() {
+        if (used == 4) {
+            bits = philoxStream(seed, stream, block++);
+            used = 0;
+        }
+        return bits.v[used++];
+    }
+
+    // Unbiased integer in [0, range) by Lemire's multiply-shift with rejection
+    uint32_t below(uint32_t range) {
+        uint64_t product = static_cast<uint64_t>(next()) * range;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < range) {
+            uint32_t threshold = (0u - range) % range;
+            while (low < threshold) {
+                product = static_cast<uint64_t>(next()) * range;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+private:
+    uint64_t seed;
+    uint64_t stream;
+    uint64_t block;
+    int used;
+    PhiloxBlock bits;
+};
+
+// Integer totals of a set of walkers; merging is exact, so results do not depend on the thread count
+struct PassageStatistics {
+    long long walkers = 0;
+    long long absorbed = 0;
+    unsigned long long sumTime = 0;                  // Over absorbed walkers
+    unsigned __int128 sumSquaredTime = 0;
+    long long timeHistogram[32] = {0};               // Absorbed walkers by floor(log2(time))
+    unsigned long long survivorSquaredDistance = 0;  // Sum of |r|^2 over walkers still free at the end
+
+    void merge(const PassageStatistics& other) {
+        walkers += other.walkers;
+        absorbed += other.absorbed;
+        sumTime += other.sumTime;
+        sumSquaredTime += other.sumSquaredTime;
+        for (int bin = 0; bin < 32; ++bin) {
+            timeHistogram[bin] += other.timeHistogram[bin];
+        }
+        survivorSquaredDistance += other.survivorSquaredDistance;
+    }
+
+    double meanTime() const { return absorbed ? static_cast<double>(sumTime) / absorbed : 0.0; }
+
+    double timeDeviation() const {
+        if (absorbed < 2) {
+            return 0.0;
+        }
+        double mean = meanTime();
+        double variance = (static_cast<double>(sumSquaredTime) - absorbed * mean * mean) / (absorbed - 1);
+        return std::sqrt(std::max(0.0, variance));
+    }
+};
+
+// Walk walkers [start, end) for at most maxSteps steps each. Everything that varies by configuration is a
+// template parameter, so the loop below compiles to a fixed move table and straight-line box tests.
+template <int D, typename Neighbourhood, Boundary B>
+void walkLattice(const LatticeMap& map, long long start, long long end, int maxSteps, uint32_t seed, PassageStatistics& statistics) {
+    int moves[Neighbourhood::NUM_MOVES][D];
+    for (int move = 0; move < Neighbourhood::NUM_MOVES; ++move) {
+        Neighbourhood::delta(move, moves[move]);
+    }
+    const int L = map.getHalfWidth();
+
+    // Flat-index offset of every move, so the cell index is updated incrementally
+    long long moveOffset[Neighbourhood::NUM_MOVES];
+    for (int move = 0; move < Neighbourhood::NUM_MOVES; ++move) {
+        long long offset = 0, stride = 1;
+        for (int axis = 0; axis < D; ++axis) {
+            offset += moves[move][axis] * stride;
+            stride *= 2 * L + 1;
+        }
+        moveOffset[move] = offset;
+    }
+
+    for (long long walker = start; walker < end; ++walker) {
+        PhiloxWords random((2ull << 32) | seed, static_cast<uint64_t>(walker));
+        int position[D] = {0};
+        uint64_t cell = map.index(position);
+        bool absorbed = false;
+        int time = 0;
+
+        while (time < maxSteps) {
+            int move = static_cast<int>(random.below(Neighbourhood::NUM_MOVES));
+            ++time;
+
+            bool inside = true;
+            int candidate[D];
+            for (int axis = 0; axis < D; ++axis) {
+                candidate[axis] = position[axis] + moves[move][axis];
+                inside &= (candidate[axis] >= -L) & (candidate[axis] <= L);
+            }
+            if (!inside) {
+                if (B == Boundary::Absorbing) {
+                    absorbed = true;
+                    break;
+                }
+                continue;  // Reflecting: stay put
+            }
+
+            uint64_t next = cell + moveOffset[move];
+            if (map.isObstacle(next)) {
+                continue;
+            }
+            for (int axis = 0; axis < D; ++axis) {
+                position[axis] = candidate[axis];
+            }
+            cell = next;
+            if (map.isTrap(cell)) {
+                absorbed = true;
+                break;
+            }
+        }
+
+        ++statistics.walkers;
+        if (absorbed) {
+            ++statistics.absorbed;
+            statistics.sumTime += time;
+            statistics.sumSquaredTime += static_cast<unsigned __int128>(time) * time;
+            ++statistics.timeHistogram[63 - __builtin_clzll(static_cast<unsigned long long>(time))];
+        } else {
+            unsigned long long r2 = 0;
+            for (int axis = 0; axis < D; ++axis) {
+                r2 += static_cast<long long>(position[axis]) * position[axis];
+            }
+            statistics.survivorSquaredDistance += r2;
+        }
+    }
+}
+
+// Run numWalkers walkers of one compiled configuration across numThreads threads
+template <int D, typename Neighbourhood, Boundary B>
+PassageStatistics runLatticeWalkers(const LatticeMap& map, long long numWalkers, int maxSteps, uint32_t seed, int numThreads) {
+    numThreads = static_cast<int>(std::max<long long>(1, std::min<long long>(numThreads, numWalkers)));
+    std::vector<PassageStatistics> partials(numThreads);
+    std::vector<std::thread> threads(numThreads);
+    for (int t = 0; t < numThreads; ++t) {
+        long long start = numWalkers * t / numThreads;
+        long long end = numWalkers * (t + 1) / numThreads;
+        threads[t] = std::thread(walkLattice<D, Neighbourhood, B>, std::cref(map), start, end, maxSteps, seed, std::ref(partials[t]));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    PassageStatistics total;
+    for (const auto& partial : partials) {
+        total.merge(partial);
+    }
+    return total;
+}
+
+// Pick the boundary specialisation
+template <int D, typename Neighbourhood>
+PassageStatistics dispatchBoundary(const LatticeMap& map, Boundary boundary, long long numWalkers, int maxSteps, uint32_t seed, int numThreads) {
+    if (boundary == Boundary::Absorbing) {
+        return runLatticeWalkers<D, Neighbourhood, Boundary::Absorbing>(map, numWalkers, maxSteps, seed, numThreads);
+    }
+    return runLatticeWalkers<D, Neighbourhood, Boundary::Reflecting>(map, numWalkers, maxSteps, seed, numThreads);
+}
+
+// Pick the neighbourhood specialisation
+template <int D>
+PassageStatistics dispatchNeighbourhood(const LatticeMap& map, bool moore, Boundary boundary, long long numWalkers, int maxSteps,
+                                        uint32_t seed, int numThreads) {
+    if (moore) {
+        return dispatchBoundary<D, Moore<D>>(map, boundary, numWalkers, maxSteps, seed, numThreads);
+    }
+    return dispatchBoundary<D, VonNeumann<D>>(map, boundary, numWalkers, maxSteps, seed, numThreads);
+}
+
+// Largest dimension with a compiled engine
+constexpr int MAX_LATTICE_DIMENSION = 4;
+
+// Run the compiled engine matching the runtime configuration (dimension 1 to MAX_LATTICE_DIMENSION)
+inline PassageStatistics runLatticeWalks(const LatticeMap& map, bool moore, Boundary boundary, long long numWalkers, int maxSteps,
+                                         uint32_t seed, int numThreads) {
+    switch (map.getDimension()) {
+    case 1:
+        return dispatchNeighbourhood<1>(map, moore, boundary, numWalkers, maxSteps, seed, numThreads);
+    case 2:
+        return dispatchNeighbourhood<2>(map, moore, boundary, numWalkers, maxSteps, seed, numThreads);
+    case 3:
+        return dispatchNeighbourhood<3>(map, moore, boundary, numWalkers, maxSteps, seed, numThreads);
+    default:
+        return dispatchNeighbourhood<4>(map, moore, boundary, numWalkers, maxSteps, seed, numThreads);
+    }
+}
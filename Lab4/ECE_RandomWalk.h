@@ -0,0 +1,225 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: CPU kernels for the 2D random-walk simulator. Walker w draws its steps from the Philox stream
+(seed, w); every 128-bit block holds 64 steps as 2-bit directions, which are applied 16 at a time by counting
+bits instead of branching per step. Walkers run in fixed-size batches through two reusable buffer sets: the
+std::threads simulate one batch while the previous one is folded into streaming statistics, so the result is
+the same for any thread count and memory does not grow with the number of walkers. When only endpoints are needed,
+the multinomial method draws the step counts directly in O(1) per walker.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+#include "ECE_Philox.h"
+#include "ECE_Binomial.h"
+#include "ECE_WalkStatistics.h"
+
+// 2-bit direction codes, as in the CUDA kernel: the high bit selects the axis, the low bit the sign
+#define NORTH 0
+#define SOUTH 1
+#define EAST  2
+#define WEST  3
+
+constexpr int STEPS_PER_WORD = 16;                 // 2-bit directions in a 32-bit word
+constexpr int STEPS_PER_BLOCK = 4 * STEPS_PER_WORD;
+constexpr uint32_t LOW_BITS = 0x55555555u;         // Bit 0 of every 2-bit field
+constexpr int WALKER_LANES = 8;                    // Walkers advanced together by the SIMD loop
+
+// How each walker's endpoint is produced
+enum class WalkMethod {
+    StepByStep,     // Every step drawn and applied
+    Multinomial     // Only the N/S/E/W step counts are drawn
+};
+
+// Start and end of the work assigned to one thread
+struct WalkRange {
+    int start;
+    int end;
+};
+
+// Split total items into at most maxThreads contiguous ranges
+inline std::vector<WalkRange> splitWalkers(int total, int maxThreads) {
+    std::vector<WalkRange> ranges;
+    int numThreads = std::max(1, std::min(maxThreads, total));
+    int base = total / numThreads;
+    int extra = total % numThreads;
+    int start = 0;
+    for (int t = 0; t < numThreads; ++t) {
+        int end = start + base + (t < extra ? 1 : 0);
+        ranges.push_back(WalkRange{start, end});
+        start = end;
+    }
+    return ranges;
+}
+
+// Apply the directions held in one random word. fieldMask keeps bit 0 of every field that is a real step.
+inline void applyWord(uint32_t word, uint32_t fieldMask, int& x, int& y) {
+    uint32_t sign = word & fieldMask;
+    uint32_t axis = (word >> 1) & fieldMask;
+    int horizontal = __builtin_popcount(axis);              // EAST or WEST
+    int vertical = __builtin_popcount(fieldMask) - horizontal;
+    int west = __builtin_popcount(axis & sign);
+    int south = __builtin_popcount(~axis & sign);
+    x += horizontal - 2 * west;
+    y += vertical - 2 * south;
+}
+
+// Field mask for the word holding steps [first, first + 16) of a walk with numSteps steps
+inline uint32_t wordMask(long long first, int numSteps) {
+    long long remaining = numSteps - first;
+    if (remaining >= STEPS_PER_WORD) {
+        return LOW_BITS;
+    }
+    if (remaining <= 0) {
+        return 0u;
+    }
+    return LOW_BITS & ((1u << (2 * remaining)) - 1u);
+}
+
+// Endpoint of one walker
+inline void walkEndpoint(uint32_t seed, uint64_t walker, int numSteps, int& x, int& y) {
+    x = 0;
+    y = 0;
+    long long numBlocks = (static_cast<long long>(numSteps) + STEPS_PER_BLOCK - 1) / STEPS_PER_BLOCK;
+    for (long long block = 0; block < numBlocks; ++block) {
+        PhiloxBlock bits = philoxStream(seed, walker, block);
+        for (int w = 0; w < 4; ++w) {
+            applyWord(bits.v[w], wordMask(block * STEPS_PER_BLOCK + w * STEPS_PER_WORD, numSteps), x, y);
+        }
+    }
+}
+
+// Endpoints of walkers firstWalker + [start, end), written to x_walks[start, end). Full groups of WALKER_LANES
+// walkers share the block loop so the Philox rounds and bit counts of the group vectorise; the tail is done one
+// walker at a time.
+inline void simulateWalkers(int* x_walks, int* y_walks, uint64_t firstWalker, int start, int end, int numSteps, uint32_t seed) {
+    long long numBlocks = (static_cast<long long>(numSteps) + STEPS_PER_BLOCK - 1) / STEPS_PER_BLOCK;
+    int i = start;
+
+    for (; i + WALKER_LANES <= end; i += WALKER_LANES) {
+        int x[WALKER_LANES] = {0};
+        int y[WALKER_LANES] = {0};
+        for (long long block = 0; block < numBlocks; ++block) {
+            uint32_t masks[4];
+            for (int w = 0; w < 4; ++w) {
+                masks[w] = wordMask(block * STEPS_PER_BLOCK + w * STEPS_PER_WORD, numSteps);
+            }
+            #pragma omp simd
+            for (int lane = 0; lane < WALKER_LANES; ++lane) {
+                PhiloxBlock bits = philoxStream(seed, firstWalker + i + lane, block);
+                int dx = 0, dy = 0;
+                for (int w = 0; w < 4; ++w) {
+                    applyWord(bits.v[w], masks[w], dx, dy);
+                }
+                x[lane] += dx;
+                y[lane] += dy;
+            }
+        }
+        for (int lane = 0; lane < WALKER_LANES; ++lane) {
+            x_walks[i + lane] = x[lane];
+            y_walks[i + lane] = y[lane];
+        }
+    }
+
+    for (; i < end; ++i) {
+        walkEndpoint(seed, firstWalker + i, numSteps, x_walks[i], y_walks[i]);
+    }
+}
+
+// Endpoint of one walker from its step counts. The endpoint only depends on how many steps went each way,
+// and (N, S, E, W) ~ Multinomial(n; 1/4, 1/4, 1/4, 1/4) splits as V ~ Bin(n, 1/2) vertical steps,
+// N ~ Bin(V, 1/2) and E ~ Bin(n - V, 1/2), so three binomial draws give the exact endpoint distribution.
+// The uniforms come from a separate key space (high seed word 1) so they never overlap the step streams.
+inline void sampleEndpoint(uint32_t seed, uint64_t walker, int numSteps, int& x, int& y) {
+    PhiloxUniform uniform((1ull << 32) | seed, walker);
+    long long vertical = sampleBinomial(numSteps, 0.5, uniform);
+    long long horizontal = numSteps - vertical;
+    long long north = sampleBinomial(vertical, 0.5, uniform);
+    long long east = sampleBinomial(horizontal, 0.5, uniform);
+    x = static_cast<int>(2 * east - horizontal);
+    y = static_cast<int>(2 * north - vertical);
+}
+
+// Endpoints of walkers firstWalker + [start, end) by multinomial sampling, O(1) expected work per walker
+inline void sampleWalkers(int* x_walks, int* y_walks, uint64_t firstWalker, int start, int end, int numSteps, uint32_t seed) {
+    for (int i = start; i < end; ++i) {
+        sampleEndpoint(seed, firstWalker + i, numSteps, x_walks[i], y_walks[i]);
+    }
+}
+
+// Start walkers firstWalker + [0, count) on numThreads threads; the caller joins the returned threads.
+inline std::vector<std::thread> launchWalkers(int* x_walks, int* y_walks, uint64_t firstWalker, int count, int num_steps,
+                                              uint32_t seed, int numThreads, WalkMethod method) {
+    auto ranges = splitWalkers(count, numThreads);
+    std::vector<std::thread> threads(ranges.size());
+    auto kernel = (method == WalkMethod::Multinomial) ? sampleWalkers : simulateWalkers;
+    for (size_t t = 0; t < ranges.size(); ++t) {
+        threads[t] = std::thread(kernel, x_walks, y_walks, firstWalker, ranges[t].start, ranges[t].end, num_steps, seed);
+    }
+    return threads;
+}
+
+// Run every walker, split across numThreads threads.
+inline void runRandomWalks(int* x_walks, int* y_walks, int num_walks, int num_steps, uint32_t seed, int numThreads,
+                           WalkMethod method = WalkMethod::StepByStep) {
+    auto threads = launchWalkers(x_walks, y_walks, 0, num_walks, num_steps, seed, numThreads, method);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+// Two sets of batch buffers that batches are simulated into alternately
+struct WalkBuffers {
+    int* x[2];
+    int* y[2];
+    int capacity;   // Walkers per batch
+};
+
+// Walkers per batch buffer (a multiple of MOMENT_CHUNK); four such int arrays bound the memory of a run
+constexpr int BATCH_WALKERS = 1 << 18;
+
+// Walkers per batch for a run of num_walks
+inline int batchCapacity(long long num_walks) {
+    return static_cast<int>(std::min<long long>(num_walks, BATCH_WALKERS));
+}
+
+// Simulate num_walks walkers in batches through the two buffer sets. While the workers simulate batch b + 1
+// the calling thread reduces batch b, so memory stays at two batches however many walkers are requested and
+// the reduction never competes with the simulation threads for cores.
+inline WalkStatistics runWalkerBatches(const WalkBuffers& buffers, long long num_walks, int num_steps, uint32_t seed,
+                                       int numThreads, WalkMethod method) {
+    WalkStatistics statistics(num_steps, 1);
+    long long numBatches = (num_walks + buffers.capacity - 1) / buffers.capacity;
+    auto batchSize = [&](long long batch) {
+        return static_cast<int>(std::min<long long>(buffers.capacity, num_walks - batch * buffers.capacity));
+    };
+
+    std::vector<std::thread> running;
+    if (numBatches > 0) {
+        running = launchWalkers(buffers.x[0], buffers.y[0], 0, batchSize(0), num_steps, seed, numThreads, method);
+    }
+    for (long long batch = 0; batch < numBatches; ++batch) {
+        for (auto& thread : running) {
+            thread.join();
+        }
+        running.clear();
+
+        int current = batch % 2;
+        if (batch + 1 < numBatches) {
+            int next = 1 - current;
+            running = launchWalkers(buffers.x[next], buffers.y[next], (batch + 1) * buffers.capacity, batchSize(batch + 1),
+                                    num_steps, seed, numThreads, method);
+        }
+        statistics.addBatch(buffers.x[current], buffers.y[current], batchSize(batch));
+    }
+
+    return statistics;
+}
@@ -0,0 +1,258 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Full-trajectory recording for the CPU random-walk backend. Every step is kept as 2 bits split over
+two bit-planes per walker (axis: 1 = EAST/WEST, sign: 1 = SOUTH/WEST), 64 steps per plane word, and batches of
+walkers are written straight into a memory-mapped file. While a walker is recorded its planes are analysed:
+mean-squared displacement at log-spaced checkpoints, velocity autocorrelation at a few lags and returns to
+the origin. All accumulators are integers, so the results do not depend on the thread count.
+
+File layout: TrajectoryHeader, then for each walker its axis plane words followed by its sign plane words.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "ECE_Philox.h"
+
+// Lags at which the velocity autocorrelation is measured (all below 64)
+const int VACF_LAGS[] = {1, 2, 3, 4, 8, 16, 32};
+constexpr int NUM_VACF_LAGS = sizeof(VACF_LAGS) / sizeof(VACF_LAGS[0]);
+
+// Fixed-size file header
+struct TrajectoryHeader {
+    char magic[8];            // "ECEWALK1"
+    uint64_t numWalkers;
+    uint64_t numSteps;
+    uint64_t wordsPerPlane;   // ceil(numSteps / 64)
+    uint64_t seed;
+    uint64_t reserved[3];
+};
+
+// Integer accumulators of one thread
+struct TrajectoryPartial {
+    std::vector<long long> squaredDisplacement;   // Sum of x^2 + y^2 at every checkpoint
+    long long vacf[NUM_VACF_LAGS] = {0};          // Sum of v(t) . v(t + lag)
+    long long returns = 0;                        // Visits to the origin after t = 0
+    long long walkersReturned = 0;                // Walkers that came back at least once
+};
+
+// Gather the 16 even bits of a word into its low half
+inline uint32_t compactEvenBits(uint32_t x) {
+    x &= 0x55555555u;
+    x = (x | (x >> 1)) & 0x33333333u;
+    x = (x | (x >> 2)) & 0x0F0F0F0Fu;
+    x = (x | (x >> 4)) & 0x00FF00FFu;
+    x = (x | (x >> 8)) & 0x0000FFFFu;
+    return x;
+}
+
+// Log-spaced checkpoints (ten per decade, rounded and de-duplicated) ending at numSteps
+inline std::vector<int> msdCheckpoints(int numSteps) {
+    std::vector<int> checkpoints;
+    for (int k = 0;; ++k) {
+        double t = std::round(std::pow(10.0, k / 10.0));
+        if (t >= numSteps) {
+            break;
+        }
+        if (checkpoints.empty() || checkpoints.back() != static_cast<int>(t)) {
+            checkpoints.push_back(static_cast<int>(t));
+        }
+    }
+    checkpoints.push_back(numSteps);
+    return checkpoints;
+}
+
+// Fill the planes of one walker from its Philox stream; the same steps as the step-by-step walk
+inline void recordPlanes(uint32_t seed, uint64_t walker, int numSteps, uint64_t* axisPlane, uint64_t* signPlane) {
+    long long words = (static_cast<long long>(numSteps) + 63) / 64;
+    for (long long b = 0; b < words; ++b) {
+        PhiloxBlock bits = philoxStream(seed, walker, b);
+        uint64_t axis = 0, sign = 0;
+        for (int w = 0; w < 4; ++w) {
+            axis |= static_cast<uint64_t>(compactEvenBits(bits.v[w] >> 1)) << (16 * w);
+            sign |= static_cast<uint64_t>(compactEvenBits(bits.v[w])) << (16 * w);
+        }
+        long long valid = numSteps - 64 * b;
+        if (valid < 64) {
+            uint64_t mask = (1ull << valid) - 1ull;
+            axis &= mask;
+            sign &= mask;
+        }
+        axisPlane[b] = axis;
+        signPlane[b] = sign;
+    }
+}
+
+// Replay the planes of one walker into the accumulators
+inline void analysePlanes(const uint64_t* axisPlane, const uint64_t* signPlane, int numSteps,
+                          const std::vector<int>& checkpoints, TrajectoryPartial& partial) {
+    long long words = (static_cast<long long>(numSteps) + 63) / 64;
+
+    // Positions step by step: returns to the origin and the checkpoint displacements
+    int x = 0, y = 0;
+    size_t next = 0;
+    long long returns = 0;
+    for (long long b = 0; b < words; ++b) {
+        uint64_t axis = axisPlane[b], sign = signPlane[b];
+        int steps = static_cast<int>(std::min<long long>(64, numSteps - 64 * b));
+        for (int j = 0; j < steps; ++j) {
+            int horizontal = static_cast<int>((axis >> j) & 1u);
+            int direction = 1 - 2 * static_cast<int>((sign >> j) & 1u);
+            x += horizontal * direction;
+            y += (1 - horizontal) * direction;
+            returns += (x == 0) & (y == 0);
+
+            long long t = 64 * b + j + 1;
+            if (t == checkpoints[next]) {
+                partial.squaredDisplacement[next] += static_cast<long long>(x) * x + static_cast<long long>(y) * y;
+                ++next;
+            }
+        }
+    }
+    partial.returns += returns;
+    partial.walkersReturned += (returns > 0);
+
+    // v(t) . v(t + lag) is +1 for equal steps, -1 for opposite ones and 0 across axes:
+    // counted a word at a time by comparing each plane with itself shifted by the lag
+    for (int l = 0; l < NUM_VACF_LAGS; ++l) {
+        int lag = VACF_LAGS[l];
+        long long sum = 0;
+        for (long long b = 0; b < words; ++b) {
+            long long validPairs = numSteps - lag - 64 * b;
+            if (validPairs <= 0) {
+                break;
+            }
+            uint64_t nextAxis = (b + 1 < words) ? axisPlane[b + 1] : 0;
+            uint64_t nextSign = (b + 1 < words) ? signPlane[b + 1] : 0;
+            uint64_t laggedAxis = (axisPlane[b] >> lag) | (nextAxis << (64 - lag));
+            uint64_t laggedSign = (signPlane[b] >> lag) | (nextSign << (64 - lag));
+            uint64_t valid = (validPairs >= 64) ? ~0ull : (1ull << validPairs) - 1ull;
+            uint64_t sameAxis = ~(axisPlane[b] ^ laggedAxis) & valid;
+            uint64_t sameSign = ~(signPlane[b] ^ laggedSign);
+            sum += __builtin_popcountll(sameAxis & sameSign) - __builtin_popcountll(sameAxis & ~sameSign);
+        }
+        partial.vacf[l] += sum;
+    }
+}
+
+// Time-resolved statistics of a recorded run
+struct TrajectoryResult {
+    std::vector<int> checkpoints;
+    std::vector<double> msd;                 // <x^2 + y^2> at each checkpoint
+    double vacf[NUM_VACF_LAGS];              // <v(t) . v(t + lag)>
+    double returnsPerWalker;
+    double returnFraction;                   // Walkers that revisited the origin
+    bool ok;
+};
+
+// Record numWalkers trajectories into the file at path and analyse them in the same pass. Walkers go in
+// batches of batchWalkers; after each batch its part of the mapping is flushed and dropped from memory.
+inline TrajectoryResult recordTrajectories(const std::string& path, long long numWalkers, int numSteps, uint32_t seed,
+                                           int numThreads, int batchWalkers) {
+    TrajectoryResult result;
+    result.ok = false;
+    result.checkpoints = msdCheckpoints(numSteps);
+
+    uint64_t wordsPerPlane = (static_cast<uint64_t>(numSteps) + 63) / 64;
+    uint64_t walkerBytes = 2 * wordsPerPlane * sizeof(uint64_t);
+    uint64_t fileBytes = sizeof(TrajectoryHeader) + numWalkers * walkerBytes;
+
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return result;
+    }
+    if (ftruncate(fd, static_cast<off_t>(fileBytes)) != 0) {
+        close(fd);
+        return result;
+    }
+    void* mapping = mmap(nullptr, fileBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return result;
+    }
+
+    TrajectoryHeader header = {};
+    std::memcpy(header.magic, "ECEWALK1", 8);
+    header.numWalkers = numWalkers;
+    header.numSteps = numSteps;
+    header.wordsPerPlane = wordsPerPlane;
+    header.seed = seed;
+    std::memcpy(mapping, &header, sizeof(header));
+    char* planes = static_cast<char*>(mapping) + sizeof(TrajectoryHeader);
+
+    numThreads = std::max(1, numThreads);
+    std::vector<TrajectoryPartial> partials(numThreads);
+    for (auto& partial : partials) {
+        partial.squaredDisplacement.assign(result.checkpoints.size(), 0);
+    }
+
+    long long pageSize = sysconf(_SC_PAGESIZE);
+    for (long long first = 0; first < numWalkers; first += batchWalkers) {
+        long long count = std::min<long long>(batchWalkers, numWalkers - first);
+        std::vector<std::thread> threads(numThreads);
+        for (int t = 0; t < numThreads; ++t) {
+            long long start = first + count * t / numThreads;
+            long long end = first + count * (t + 1) / numThreads;
+            threads[t] = std::thread([&, start, end, t]() {
+                for (long long walker = start; walker < end; ++walker) {
+                    uint64_t* axisPlane = reinterpret_cast<uint64_t*>(planes + walker * walkerBytes);
+                    uint64_t* signPlane = axisPlane + wordsPerPlane;
+                    recordPlanes(seed, walker, numSteps, axisPlane, signPlane);
+                    analysePlanes(axisPlane, signPlane, numSteps, result.checkpoints, partials[t]);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        // Hand the finished batch to the page cache and drop it from this process
+        uintptr_t begin = reinterpret_cast<uintptr_t>(planes + first * walkerBytes) & ~static_cast<uintptr_t>(pageSize - 1);
+        uintptr_t end = reinterpret_cast<uintptr_t>(planes + (first + count) * walkerBytes) & ~static_cast<uintptr_t>(pageSize - 1);
+        if (end > begin) {
+            msync(reinterpret_cast<void*>(begin), end - begin, MS_ASYNC);
+            madvise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+        }
+    }
+
+    msync(mapping, fileBytes, MS_SYNC);
+    munmap(mapping, fileBytes);
+
+    // Merge the integer partials; the order does not matter
+    TrajectoryPartial total;
+    total.squaredDisplacement.assign(result.checkpoints.size(), 0);
+    for (const auto& partial : partials) {
+        for (size_t k = 0; k < result.checkpoints.size(); ++k) {
+            total.squaredDisplacement[k] += partial.squaredDisplacement[k];
+        }
+        for (int l = 0; l < NUM_VACF_LAGS; ++l) {
+            total.vacf[l] += partial.vacf[l];
+        }
+        total.returns += partial.returns;
+        total.walkersReturned += partial.walkersReturned;
+    }
+
+    for (size_t k = 0; k < result.checkpoints.size(); ++k) {
+        result.msd.push_back(static_cast<double>(total.squaredDisplacement[k]) / numWalkers);
+    }
+    for (int l = 0; l < NUM_VACF_LAGS; ++l) {
+        double pairs = static_cast<double>(numWalkers) * std::max(0, numSteps - VACF_LAGS[l]);
+        result.vacf[l] = (pairs > 0.0) ? total.vacf[l] / pairs : 0.0;
+    }
+    result.returnsPerWalker = static_cast<double>(total.returns) / numWalkers;
+    result.returnFraction = static_cast<double>(total.walkersReturned) / numWalkers;
+    result.ok = true;
+    return result;
+}
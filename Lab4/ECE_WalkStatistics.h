@@ -0,0 +1,210 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Streaming statistics of random-walk endpoints: count, mean, variance, skewness and kurtosis of the
+distance from the origin, a 2D endpoint occupancy histogram and a radial histogram for distance quantiles.
+Each batch is reduced by several threads into private histograms that are only merged when read, so there is
+no shared counter to contend on. Moments are formed per fixed chunk and merged in chunk order, so they do
+not depend on the thread count.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+constexpr int MOMENT_CHUNK = 4096;        // Walkers per moment partial
+constexpr int OCCUPANCY_BINS = 64;        // Bins per axis of the 2D endpoint histogram
+constexpr int RADIAL_BINS = 4096;         // Bins of the distance histogram used for quantiles
+
+// Count, mean and central moment sums M2..M4 of a set of values; two sets merge exactly (Pebay, 2008)
+struct MomentAccumulator {
+    double n = 0.0;
+    double mean = 0.0;
+    double M2 = 0.0;
+    double M3 = 0.0;
+    double M4 = 0.0;
+
+    void merge(const MomentAccumulator& other) {
+        if (other.n == 0.0) {
+            return;
+        }
+        if (n == 0.0) {
+            *this = other;
+            return;
+        }
+        double na = n, nb = other.n, total = na + nb;
+        double delta = other.mean - mean;
+        double delta2 = delta * delta;
+        M4 += other.M4 + delta2 * delta2 * na * nb * (na * na - na * nb + nb * nb) / (total * total * total)
+              + 6.0 * delta2 * (na * na * other.M2 + nb * nb * M2) / (total * total)
+              + 4.0 * delta * (na * other.M3 - nb * M3) / total;
+        M3 += other.M3 + delta2 * delta * na * nb * (na - nb) / (total * total)
+              + 3.0 * delta * (na * other.M2 - nb * M2) / total;
+        M2 += other.M2 + delta2 * na * nb / total;
+        mean += delta * nb / total;
+        n = total;
+    }
+
+    double variance() const { return (n > 1.0) ? M2 / (n - 1.0) : 0.0; }
+    double skewness() const { return (M2 > 0.0) ? std::sqrt(n) * M3 / std::pow(M2, 1.5) : 0.0; }
+    double excessKurtosis() const { return (M2 > 0.0) ? n * M4 / (M2 * M2) - 3.0 : 0.0; }
+};
+
+// Private accumulators of one reducer thread
+struct HistogramPartial {
+    std::vector<uint64_t> occupancy;     // OCCUPANCY_BINS x OCCUPANCY_BINS, row = y bin
+    uint64_t occupancyOutside = 0;       // Endpoints outside the occupancy window
+    std::vector<uint64_t> radial;        // RADIAL_BINS over [0, maxRadius)
+    uint64_t radialBeyond = 0;           // Distances >= maxRadius
+};
+
+class WalkStatistics {
+public:
+    // Histogram ranges follow the walk length: each coordinate has standard deviation sqrt(n / 2), the
+    // occupancy window covers +-4 of those and the radial histogram runs to 5 sqrt(n). Batches are reduced on
+    // numThreads threads; with one they are reduced on the calling thread.
+    WalkStatistics(int numSteps, int numThreads)
+        : numThreads(std::max(1, numThreads)), partials(std::max(1, numThreads)) {
+        double sigma = std::sqrt(std::max(1, numSteps) / 2.0);
+        halfWidth = 4.0 * sigma;
+        maxRadius = 5.0 * std::sqrt(static_cast<double>(std::max(1, numSteps)));
+        for (auto& partial : partials) {
+            partial.occupancy.assign(OCCUPANCY_BINS * OCCUPANCY_BINS, 0);
+            partial.radial.assign(RADIAL_BINS, 0);
+        }
+    }
+
+    // Fold one batch of endpoints in. Batches must arrive in walker order.
+    void addBatch(const int* x_walks, const int* y_walks, int n) {
+        int numChunks = (n + MOMENT_CHUNK - 1) / MOMENT_CHUNK;
+        std::vector<MomentAccumulator> chunkMoments(numChunks);
+
+        int numReducers = std::min(numThreads, std::max(1, numChunks));
+        if (numReducers == 1) {
+            reduceChunks(x_walks, y_walks, n, 0, numChunks, partials[0], chunkMoments.data());
+        } else {
+            std::vector<std::thread> threads(numReducers);
+            for (int t = 0; t < numReducers; ++t) {
+                int firstChunk = static_cast<int>(static_cast<long long>(numChunks) * t / numReducers);
+                int lastChunk = static_cast<int>(static_cast<long long>(numChunks) * (t + 1) / numReducers);
+                threads[t] = std::thread(&WalkStatistics::reduceChunks, this, x_walks, y_walks, n, firstChunk, lastChunk,
+                                         std::ref(partials[t]), chunkMoments.data());
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+
+        for (const auto& chunk : chunkMoments) {
+            moments.merge(chunk);
+        }
+    }
+
+    long long getCount() const { return static_cast<long long>(moments.n); }
+    double averageDistance() const { return moments.mean; }
+    const MomentAccumulator& getMoments() const { return moments; }
+
+    // Distance below which a fraction p of the walkers ended, interpolated within the radial bin
+    double distanceQuantile(double p) const {
+        std::vector<uint64_t> radial = mergedRadial();
+        double target = p * moments.n;
+        double below = 0.0;
+        double binWidth = maxRadius / RADIAL_BINS;
+        for (int bin = 0; bin < RADIAL_BINS; ++bin) {
+            if (below + radial[bin] >= target && radial[bin] > 0) {
+                return (bin + (target - below) / radial[bin]) * binWidth;
+            }
+            below += radial[bin];
+        }
+        return maxRadius;
+    }
+
+    // Merged 2D occupancy counts (row-major, row = y bin) and the number of endpoints outside the window
+    std::vector<uint64_t> occupancy(uint64_t& outside) const {
+        std::vector<uint64_t> merged(OCCUPANCY_BINS * OCCUPANCY_BINS, 0);
+        outside = 0;
+        for (const auto& partial : partials) {
+            for (size_t i = 0; i < merged.size(); ++i) {
+                merged[i] += partial.occupancy[i];
+            }
+            outside += partial.occupancyOutside;
+        }
+        return merged;
+    }
+
+    // Half width of the square occupancy window centred on the origin
+    double getOccupancyHalfWidth() const { return halfWidth; }
+
+private:
+    // Reduce chunks [firstChunk, lastChunk) into the thread's private histograms and the chunk moment slots
+    void reduceChunks(const int* x_walks, const int* y_walks, int n, int firstChunk, int lastChunk,
+                      HistogramPartial& partial, MomentAccumulator* chunkMoments) const {
+        double distance[MOMENT_CHUNK];
+        double occupancyScale = OCCUPANCY_BINS / (2.0 * halfWidth);
+        double radialScale = RADIAL_BINS / maxRadius;
+
+        for (int chunk = firstChunk; chunk < lastChunk; ++chunk) {
+            int start = chunk * MOMENT_CHUNK;
+            int count = std::min(n - start, MOMENT_CHUNK);
+
+            // Two passes over the chunk: mean, then central power sums
+            double sum = 0.0;
+            #pragma omp simd reduction(+:sum)
+            for (int i = 0; i < count; ++i) {
+                double x = x_walks[start + i], y = y_walks[start + i];
+                distance[i] = std::sqrt(x * x + y * y);
+                sum += distance[i];
+            }
+            double mean = sum / count;
+            double m2 = 0.0, m3 = 0.0, m4 = 0.0;
+            #pragma omp simd reduction(+:m2, m3, m4)
+            for (int i = 0; i < count; ++i) {
+                double d = distance[i] - mean;
+                double d2 = d * d;
+                m2 += d2;
+                m3 += d2 * d;
+                m4 += d2 * d2;
+            }
+            chunkMoments[chunk] = MomentAccumulator{static_cast<double>(count), mean, m2, m3, m4};
+
+            for (int i = 0; i < count; ++i) {
+                double fx = (x_walks[start + i] + halfWidth) * occupancyScale;
+                double fy = (y_walks[start + i] + halfWidth) * occupancyScale;
+                if (fx >= 0.0 && fx < OCCUPANCY_BINS && fy >= 0.0 && fy < OCCUPANCY_BINS) {
+                    ++partial.occupancy[static_cast<int>(fy) * OCCUPANCY_BINS + static_cast<int>(fx)];
+                } else {
+                    ++partial.occupancyOutside;
+                }
+
+                int bin = static_cast<int>(distance[i] * radialScale);
+                if (bin < RADIAL_BINS) {
+                    ++partial.radial[bin];
+                } else {
+                    ++partial.radialBeyond;
+                }
+            }
+        }
+    }
+
+    // Radial counts summed over the reducer threads
+    std::vector<uint64_t> mergedRadial() const {
+        std::vector<uint64_t> merged(RADIAL_BINS, 0);
+        for (const auto& partial : partials) {
+            for (int bin = 0; bin < RADIAL_BINS; ++bin) {
+                merged[bin] += partial.radial[bin];
+            }
+        }
+        return merged;
+    }
+
+    int numThreads;
+    double halfWidth;
+    double maxRadius;
+    MomentAccumulator moments;
+    std::vector<HistogramPartial> partials;
+};
@@ -0,0 +1,116 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Parallel driver for the templated D-dimensional lattice walks. Walkers start at the centre of a
+box of cells [-L, L]^D that may contain random obstacles and traps, and walk until they are absorbed or the
+step limit is reached. Reports the absorbed fraction and the first-passage-time distribution.
+
+Build: g++ -std=c++14 -O3 -march=native -pthread Lab4_lattice_cpu.cpp -o lattice_walk_cpu
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+#include <ctime>
+
+#include "ECE_LatticeWalk.h"
+
+int main(int argc, char* argv[]) {
+    unsigned int seed = time(NULL);
+    long long numWalkers = 0;
+    int totalSteps = 0;
+    int numThreads = std::max(1u, std::thread::hardware_concurrency());
+    int dimension = 2;
+    int halfWidth = 50;
+    bool moore = false;
+    Boundary boundary = Boundary::Absorbing;
+    double obstacleDensity = 0.0;
+    int numTraps = 0;
+
+    std::string programName = argv[0];
+    std::vector<std::string> arguments(argv + 1, argv + argc);
+
+    for (size_t i = 0; i < arguments.size(); i++) {
+        if (arguments[i] == "-W" && i + 1 < arguments.size()) {
+            numWalkers = std::stoll(arguments[i + 1]);
+        } else if (arguments[i] == "-I" && i + 1 < arguments.size()) {
+            totalSteps = std::stoi(arguments[i + 1]);
+        } else if (arguments[i] == "-S" && i + 1 < arguments.size()) {
+            seed = static_cast<unsigned int>(std::stoul(arguments[i + 1]));
+        } else if (arguments[i] == "-T" && i + 1 < arguments.size()) {
+            numThreads = std::max(1, std::stoi(arguments[i + 1]));
+        } else if (arguments[i] == "-D" && i + 1 < arguments.size()) {
+            dimension = std::stoi(arguments[i + 1]);
+        } else if (arguments[i] == "-L" && i + 1 < arguments.size()) {
+            halfWidth = std::stoi(arguments[i + 1]);
+        } else if (arguments[i] == "-N" && i + 1 < arguments.size()) {
+            moore = (arguments[i + 1] == "moore");
+        } else if (arguments[i] == "-B" && i + 1 < arguments.size()) {
+            boundary = (arguments[i + 1] == "reflecting") ? Boundary::Reflecting : Boundary::Absorbing;
+        } else if (arguments[i] == "-O" && i + 1 < arguments.size()) {
+            obstacleDensity = std::stod(arguments[i + 1]);
+        } else if (arguments[i] == "-A" && i + 1 < arguments.size()) {
+            numTraps = std::stoi(arguments[i + 1]);
+        } else if (arguments[i] == "-H") {
+            std::cerr << "Usage: " << programName << " [-W <numWalkers>] [-I <maxSteps>] [-S <seed>] [-T <threads>] [-D <1-"
+                      << MAX_LATTICE_DIMENSION << ">] [-L <halfWidth>] [-N vonneumann|moore] [-B absorbing|reflecting]"
+                      << " [-O <obstacleDensity>] [-A <numTraps>] [-H]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Set default values if no input was given
+    if (numWalkers <= 0) {
+        numWalkers = 1000;
+    }
+    if (totalSteps <= 0) {
+        totalSteps = 10000;
+    }
+    if (dimension < 1 || dimension > MAX_LATTICE_DIMENSION || halfWidth < 0 || obstacleDensity < 0.0 || obstacleDensity >= 1.0) {
+        std::cerr << "Dimension must be 1-" << MAX_LATTICE_DIMENSION << ", L >= 0 and the obstacle density in [0, 1)" << std::endl;
+        return 1;
+    }
+    if (std::pow(2.0 * halfWidth + 1.0, dimension) > 17179869184.0) {
+        std::cerr << "The box has more than 2^34 cells; reduce -L" << std::endl;
+        return 1;
+    }
+
+    LatticeMap map(dimension, halfWidth);
+    map.addRandomObstacles(obstacleDensity, seed);
+    if (numTraps < 0 || static_cast<uint64_t>(numTraps) > map.countTrapCandidates()) {
+        std::cerr << "The number of traps must be in [0, " << map.countTrapCandidates() << "], the free cells other than the origin" << std::endl;
+        return 1;
+    }
+    map.addRandomTraps(numTraps, seed);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    PassageStatistics statistics = runLatticeWalks(map, moore, boundary, numWalkers, totalSteps, seed, numThreads);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::cout << dimension << "D " << (moore ? "Moore" : "von Neumann") << " walk in [-" << halfWidth << ", " << halfWidth << "]^" << dimension
+              << " with " << (boundary == Boundary::Absorbing ? "absorbing" : "reflecting") << " walls:" << std::endl;
+    std::cout << std::setw(4) << "    Time to calculate(microsec): " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << std::endl;
+    std::cout << "    Absorbed within " << totalSteps << " steps: " << statistics.absorbed << " of " << statistics.walkers
+              << " (" << 100.0 * statistics.absorbed / statistics.walkers << "%)" << std::endl;
+    if (statistics.absorbed > 0) {
+        std::cout << "    First-passage time: mean " << statistics.meanTime() << ", standard deviation " << statistics.timeDeviation() << std::endl;
+        std::cout << "    First-passage time histogram:" << std::endl;
+        for (int bin = 0; bin < 32; ++bin) {
+            if (statistics.timeHistogram[bin] > 0) {
+                std::cout << "        [" << (1ll << bin) << ", " << (2ll << bin) << "): " << statistics.timeHistogram[bin] << std::endl;
+            }
+        }
+    }
+    long long survivors = statistics.walkers - statistics.absorbed;
+    if (survivors > 0) {
+        std::cout << "    Mean squared distance of surviving walkers: " << static_cast<double>(statistics.survivorSquaredDistance) / survivors << std::endl;
+    }
+
+    std::cout << "Bye" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,230 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: CPU memory-strategy benchmark, the host-side counterpart of the normal / pinned / unified
+comparison in Lab4_problem1.cu. For every allocation policy in ECE_HostMemory.h it measures the allocation,
+the parallel first touch, a triad bandwidth sweep, a Coulomb field sweep streaming charges from the buffer and
+the batched random-walk kernel, with one warm-up and -R timed repetitions (best and median reported), and the
+minor/major page faults taken in each phase. GB/s is reported only for the bandwidth-bound triad and field sweeps.
+
+Build: g++ -std=c++14 -O3 -march=native -fno-math-errno -fopenmp-simd -pthread Lab4_memory_cpu.cpp -o memory_benchmark_cpu
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+#include <ctime>
+#include <functional>
+
+#include "ECE_RandomWalk.h"
+#include "ECE_HostMemory.h"
+
+// Timing and page faults of one benchmark phase
+struct PhaseResult {
+    double bestSeconds;
+    double medianSeconds;
+    long minorFaults;
+    long majorFaults;
+};
+
+// Run body once to warm up, then repetitions times; faults are counted over the timed runs
+PhaseResult timePhase(int repetitions, int warmups, const std::function<void()>& body) {
+    for (int i = 0; i < warmups; ++i) {
+        body();
+    }
+    long minorBefore, majorBefore, minorAfter, majorAfter;
+    pageFaults(minorBefore, majorBefore);
+    std::vector<double> seconds;
+    for (int i = 0; i < repetitions; ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        body();
+        auto end = std::chrono::high_resolution_clock::now();
+        seconds.push_back(std::chrono::duration<double>(end - start).count());
+    }
+    pageFaults(minorAfter, majorAfter);
+    std::sort(seconds.begin(), seconds.end());
+    return PhaseResult{seconds.front(), seconds[seconds.size() / 2], minorAfter - minorBefore, majorAfter - majorBefore};
+}
+
+// Run body(start, end) over [0, count) split across numThreads threads
+void parallelFor(size_t count, int numThreads, const std::function<void(size_t, size_t)>& body) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        size_t start = count * t / numThreads;
+        size_t end = count * (t + 1) / numThreads;
+        threads.emplace_back(body, start, end);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+// Print one row of the results table
+void printPhase(const char* name, const PhaseResult& result, double bytes) {
+    std::cout << "    " << std::left << std::setw(14) << name << std::right
+              << std::setw(12) << std::fixed << std::setprecision(3) << result.bestSeconds * 1e3
+              << std::setw(12) << result.medianSeconds * 1e3;
+    if (bytes > 0.0) {
+        std::cout << std::setw(12) << std::setprecision(2) << bytes / result.bestSeconds / 1e9;
+    } else {
+        std::cout << std::setw(12) << "-";
+    }
+    std::cout << std::setw(12) << result.minorFaults << std::setw(8) << result.majorFaults << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+// Benchmark one allocation policy
+void benchmarkPolicy(HostPolicy policy, size_t bytes, int repetitions, long long numWalkers, int numSteps, unsigned int seed, int numThreads) {
+    std::cout << hostPolicyName(policy) << ":" << std::endl;
+
+    // Allocation alone; a single run since the buffer is kept for the other phases
+    long minorBefore, majorBefore, minorAfter, majorAfter;
+    pageFaults(minorBefore, majorBefore);
+    auto start = std::chrono::high_resolution_clock::now();
+    HostBuffer buffer(policy, bytes);
+    auto end = std::chrono::high_resolution_clock::now();
+    pageFaults(minorAfter, majorAfter);
+    if (!buffer.valid()) {
+        std::cout << "    unavailable: " << buffer.getNote() << std::endl;
+        return;
+    }
+    if (!buffer.getNote().empty()) {
+        std::cout << "    note: " << buffer.getNote() << std::endl;
+    }
+
+    std::cout << "    " << std::left << std::setw(14) << "phase" << std::right << std::setw(12) << "best(ms)" << std::setw(12) << "median(ms)"
+              << std::setw(12) << "GB/s" << std::setw(12) << "minflt" << std::setw(8) << "majflt" << std::endl;
+    double allocationSeconds = std::chrono::duration<double>(end - start).count();
+    printPhase("allocate", PhaseResult{allocationSeconds, allocationSeconds, minorAfter - minorBefore, majorAfter - majorBefore}, 0.0);
+
+    // First touch by the worker threads, each writing its own slice (this is where pages get placed)
+    double* data = static_cast<double*>(buffer.get());
+    size_t numDoubles = bytes / sizeof(double);
+    PhaseResult touch = timePhase(1, 0, [&]() {
+        parallelFor(numDoubles, numThreads, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                data[i] = 1.0;
+            }
+        });
+    });
+    // Page faults, not bandwidth, limit the first touch, so no GB/s
+    printPhase("first touch", touch, 0.0);
+
+    // Triad a = b + s * c over the three thirds of the buffer: 2 reads and 1 write per element
+    size_t third = numDoubles / 3;
+    double* a = data;
+    double* b = data + third;
+    double* c = data + 2 * third;
+    PhaseResult triad = timePhase(repetitions, 1, [&]() {
+        parallelFor(third, numThreads, [&](size_t first, size_t last) {
+            #pragma omp simd
+            for (size_t i = first; i < last; ++i) {
+                a[i] = b[i] + 3.0 * c[i];
+            }
+        });
+    });
+    printPhase("triad", triad, 3.0 * third * sizeof(double));
+
+    // Field of a quarter-buffer SoA charge set (x, y, z, q) at one probe per sweep. A single-precision 1 / r^3
+    // (vectorised once -fno-math-errno drops the errno check on sqrt) and a few multiplies per 32 bytes run
+    // several times faster than memory delivers the charges, so this sweep is bandwidth-bound like the triad
+    size_t numCharges = numDoubles / 4;
+    double* cx = data;
+    double* cy = data + numCharges;
+    double* cz = data + 2 * numCharges;
+    double* cq = data + 3 * numCharges;
+    parallelFor(numCharges, numThreads, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            cx[i] = static_cast<double>(i % 1024);
+            cy[i] = static_cast<double>(i / 1024 % 1024);
+            cz[i] = static_cast<double>(i / (1024 * 1024));
+            cq[i] = 1e-6;
+        }
+    });
+    volatile double fieldSink = 0.0;
+    PhaseResult field = timePhase(repetitions, 1, [&]() {
+        std::vector<double> partial(numThreads, 0.0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back([&, t]() {
+                size_t first = numCharges * t / numThreads;
+                size_t last = numCharges * (t + 1) / numThreads;
+                double ex = 0.0;
+                #pragma omp simd reduction(+:ex)
+                for (size_t i = first; i < last; ++i) {
+                    double dx = 0.5 - cx[i], dy = 0.5 - cy[i], dz = -1.0 - cz[i];
+                    float invR = 1.0f / std::sqrt(static_cast<float>(dx * dx + dy * dy + dz * dz));
+                    ex += cq[i] * dx * static_cast<double>(invR * invR * invR);
+                }
+                partial[t] = 9e9 * ex;
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (double value : partial) {
+            fieldSink = fieldSink + value;
+        }
+    });
+    printPhase("field", field, 4.0 * numCharges * sizeof(double));
+
+    // Batched random walks with their batch buffers carved from this allocation
+    int capacity = static_cast<int>(std::min<long long>(std::min<long long>(numWalkers, BATCH_WALKERS), bytes / (4 * sizeof(int))));
+    int* base = static_cast<int*>(buffer.get());
+    WalkBuffers walkBuffers = {{base, base + capacity}, {base + 2 * capacity, base + 3 * capacity}, capacity};
+    double averageDistance = 0.0;
+    PhaseResult walks = timePhase(repetitions, 1, [&]() {
+        averageDistance = runWalkerBatches(walkBuffers, numWalkers, numSteps, seed, numThreads, WalkMethod::StepByStep).averageDistance();
+    });
+    printPhase("random walk", walks, 0.0);
+    std::cout << "    Average distance from origin: " << averageDistance << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    unsigned int seed = time(NULL);
+    long long numWalkers = 100000;
+    int totalSteps = 1000;
+    int numThreads = std::max(1u, std::thread::hardware_concurrency());
+    size_t megabytes = 256;
+    int repetitions = 5;
+
+    std::string programName = argv[0];
+    std::vector<std::string> arguments(argv + 1, argv + argc);
+
+    for (size_t i = 0; i < arguments.size(); i++) {
+        if (arguments[i] == "-W" && i + 1 < arguments.size()) {
+            numWalkers = std::stoll(arguments[i + 1]);
+        } else if (arguments[i] == "-I" && i + 1 < arguments.size()) {
+            totalSteps = std::stoi(arguments[i + 1]);
+        } else if (arguments[i] == "-S" && i + 1 < arguments.size()) {
+            seed = static_cast<unsigned int>(std::stoul(arguments[i + 1]));
+        } else if (arguments[i] == "-T" && i + 1 < arguments.size()) {
+            numThreads = std::max(1, std::stoi(arguments[i + 1]));
+        } else if (arguments[i] == "-M" && i + 1 < arguments.size()) {
+            megabytes = std::stoul(arguments[i + 1]);
+        } else if (arguments[i] == "-R" && i + 1 < arguments.size()) {
+            repetitions = std::max(1, std::stoi(arguments[i + 1]));
+        } else if (arguments[i] == "-H") {
+            std::cerr << "Usage: " << programName << " [-M <bufferMiB>] [-R <repetitions>] [-W <numWalkers>] [-I <totalSteps>] [-S <seed>] [-T <threads>] [-H]" << std::endl;
+            return 1;
+        }
+    }
+    if (numWalkers <= 0 || totalSteps <= 0 || megabytes == 0) {
+        std::cerr << "Walkers, steps and buffer size must be > 0" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Buffer " << megabytes << " MiB, " << numThreads << " threads, " << repetitions << " timed repetitions after 1 warm-up" << std::endl;
+    for (HostPolicy policy : ALL_HOST_POLICIES) {
+        benchmarkPolicy(policy, megabytes << 20, repetitions, numWalkers, totalSteps, seed, numThreads);
+    }
+
+    std::cout << "Bye" << std::endl;
+
+    return 0;
+}
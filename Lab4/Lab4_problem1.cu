@@ -11,13 +11,20 @@
 #define EAST  2
 #define WEST  3
 
-// Kernel function for performing 2D random walks with directions
-__global__ void random_walks(int* x_walks, int* y_walks, int num_walks, int num_steps, unsigned int seed) {
+// Walkers per batch; every memory strategy keeps two batches of x and y, so memory does not grow with -W
+#define BATCH_WALKERS (1 << 20)
+
+// Kernel function for performing 2D random walks with directions.
+// Thread tid simulates walker first_walker + tid, so a batched run draws the same numbers as one big launch.
+__global__ void random_walks(int* x_walks, int* y_walks, int num_walks, int num_steps, unsigned int seed, long long first_walker) {
 
     int tid = blockIdx.x * blockDim.x + threadIdx.x;
+    if (tid >= num_walks) {
+        return;  // Last block of a batch is partly empty
+    }
 
     curandState state;
-    curand_init(seed, tid, 0, &state);  // Initialize random number generator state for each thread
+    curand_init(seed, first_walker + tid, 0, &state);  // Initialize random number generator state for each thread
 
     int x = 0;  // Start at the origin on the x-axis
     int y = 0;  // Start at the origin on the y-axis
@@ -40,110 +47,158 @@ __global__ void random_walks(int* x_walks, int* y_walks, int num_walks, int num_
     y_walks[tid] = y;
 }
 
-// Calculate the average distance of walkers from the origin
-double calculateAverageDistance(int* x_walks, int* y_walks, int num_walks) {
-    double total_distance = 0.0;
-
+// Add the distances of one batch of walkers from the origin to the running total
+void accumulateDistances(const int* x_walks, const int* y_walks, int num_walks, double& total_distance) {
     for (int i = 0; i < num_walks; i++) {
-        double distance = sqrt(x_walks[i] * x_walks[i] + y_walks[i] * y_walks[i]);
-        total_distance += distance;
+        double x = x_walks[i];
+        double y = y_walks[i];
+        total_distance += sqrt(x * x + y * y);
     }
+}
 
-    return total_distance / num_walks;
+// Walkers in batch `batch` of a run
+int batchSize(long long num_walks, long long batch) {
+    long long remaining = num_walks - batch * BATCH_WALKERS;
+    return (int)(remaining < BATCH_WALKERS ? remaining : BATCH_WALKERS);
 }
 
-// Allocate memory and perform random walks using standard CUDA memory allocation
-double normalMemoryAllocation(int num_walks, int num_steps, unsigned int seed, int threadsPerBlock, int blocksPerGrid) {
-   
-    int* d_x_walks;
-    int* d_y_walks;
-    int x_walks[num_walks];
-    int y_walks[num_walks];
+// Run all batches through two sets of buffers. Batch b + 1 is queued on its own stream before the host
+// reduces batch b, so the GPU simulates one batch while the CPU reduces the previous one.
+// d_x/d_y are what the kernel writes; h_x/h_y are what the host reads (the same pointers for managed memory).
+double runBatches(int* d_x[2], int* d_y[2], int* h_x[2], int* h_y[2], bool copyBack, cudaStream_t streams[2],
+                  long long num_walks, int num_steps, unsigned int seed, int threadsPerBlock) {
+    long long numBatches = (num_walks + BATCH_WALKERS - 1) / BATCH_WALKERS;
+    double total_distance = 0.0;
 
-    // Allocate device memory for x and y coordinates
-    cudaMalloc((void**)&d_x_walks, num_walks * sizeof(int));
-    cudaMalloc((void**)&d_y_walks, num_walks * sizeof(int));
+    auto enqueue = [&](long long batch) {
+        int buffer = batch % 2;
+        int count = batchSize(num_walks, batch);
+        int blocksPerGrid = (count + threadsPerBlock - 1) / threadsPerBlock;
+        random_walks<<<blocksPerGrid, threadsPerBlock, 0, streams[buffer]>>>(d_x[buffer], d_y[buffer], count, num_steps, seed, batch * BATCH_WALKERS);
+        if (copyBack) {
+            cudaMemcpyAsync(h_x[buffer], d_x[buffer], count * sizeof(int), cudaMemcpyDeviceToHost, streams[buffer]);
+            cudaMemcpyAsync(h_y[buffer], d_y[buffer], count * sizeof(int), cudaMemcpyDeviceToHost, streams[buffer]);
+        }
+    };
 
-    // Launch the random walk kernel
-    random_walks<<<blocksPerGrid, threadsPerBlock>>>(d_x_walks, d_y_walks, num_walks, num_steps, seed);
+    if (numBatches > 0) {
+        enqueue(0);
+    }
+    for (long long batch = 0; batch < numBatches; batch++) {
+        int buffer = batch % 2;
+        cudaStreamSynchronize(streams[buffer]);
+        if (batch + 1 < numBatches) {
+            enqueue(batch + 1);
+        }
+        accumulateDistances(h_x[buffer], h_y[buffer], batchSize(num_walks, batch), total_distance);
+    }
+
+    return total_distance / num_walks;
+}
 
-    // Copy the results back to the host
-    cudaMemcpy(x_walks, d_x_walks, num_walks * sizeof(int), cudaMemcpyDeviceToHost);
-    cudaMemcpy(y_walks, d_y_walks, num_walks * sizeof(int), cudaMemcpyDeviceToHost);
+// Allocate memory and perform random walks using standard CUDA memory allocation
+double normalMemoryAllocation(long long num_walks, int num_steps, unsigned int seed, int threadsPerBlock) {
+
+    int capacity = batchSize(num_walks, 0);
+    int* d_x_walks[2];
+    int* d_y_walks[2];
+    // Pageable host buffers on the heap (previously VLAs on the stack, which overflowed for large -W)
+    std::vector<int> x_walks[2] = {std::vector<int>(capacity), std::vector<int>(capacity)};
+    std::vector<int> y_walks[2] = {std::vector<int>(capacity), std::vector<int>(capacity)};
+    int* h_x_walks[2] = {x_walks[0].data(), x_walks[1].data()};
+    int* h_y_walks[2] = {y_walks[0].data(), y_walks[1].data()};
+    cudaStream_t streams[2];
+
+    // Allocate device memory for two batches of x and y coordinates
+    for (int i = 0; i < 2; i++) {
+        cudaMalloc((void**)&d_x_walks[i], capacity * sizeof(int));
+        cudaMalloc((void**)&d_y_walks[i], capacity * sizeof(int));
+        cudaStreamCreate(&streams[i]);
+    }
 
-    double average_distance = calculateAverageDistance(x_walks, y_walks, num_walks);
+    double average_distance = runBatches(d_x_walks, d_y_walks, h_x_walks, h_y_walks, true, streams, num_walks, num_steps, seed, threadsPerBlock);
 
     // Free device memory
-    cudaFree(d_x_walks);
-    cudaFree(d_y_walks);
+    for (int i = 0; i < 2; i++) {
+        cudaFree(d_x_walks[i]);
+        cudaFree(d_y_walks[i]);
+        cudaStreamDestroy(streams[i]);
+    }
 
     return average_distance;
 }
 
 // Allocate memory and perform random walks using pinned CUDA memory allocation
-double pinnedMemoryAllocation(int num_walks, int num_steps, unsigned int seed, int threadsPerBlock, int blocksPerGrid) {
-   
-    int* d_x_walks;
-    int* d_y_walks;
-    int* x_walks;
-    int* y_walks;
-
-    // Allocate pinned memory for x and y coordinates on the host
-    cudaMallocHost((void**)&x_walks, num_walks * sizeof(int));
-    cudaMallocHost((void**)&y_walks, num_walks * sizeof(int));
-
-    // Allocate device memory for x and y coordinates
-    cudaMalloc((void**)&d_x_walks, num_walks * sizeof(int));
-    cudaMalloc((void**)&d_y_walks, num_walks * sizeof(int));
-
-    // Launch the random walk kernel
-    random_walks<<<blocksPerGrid, threadsPerBlock>>>(d_x_walks, d_y_walks, num_walks, num_steps, seed);
+double pinnedMemoryAllocation(long long num_walks, int num_steps, unsigned int seed, int threadsPerBlock) {
+
+    int capacity = batchSize(num_walks, 0);
+    int* d_x_walks[2];
+    int* d_y_walks[2];
+    int* x_walks[2];
+    int* y_walks[2];
+    cudaStream_t streams[2];
+
+    for (int i = 0; i < 2; i++) {
+        // Allocate pinned memory for x and y coordinates on the host
+        cudaMallocHost((void**)&x_walks[i], capacity * sizeof(int));
+        cudaMallocHost((void**)&y_walks[i], capacity * sizeof(int));
+
+        // Allocate device memory for x and y coordinates
+        cudaMalloc((void**)&d_x_walks[i], capacity * sizeof(int));
+        cudaMalloc((void**)&d_y_walks[i], capacity * sizeof(int));
+        cudaStreamCreate(&streams[i]);
+    }
 
-    // Copy the results back to the host
-    cudaMemcpy(x_walks, d_x_walks, num_walks * sizeof(int), cudaMemcpyDeviceToHost);
-    cudaMemcpy(y_walks, d_y_walks, num_walks * sizeof(int), cudaMemcpyDeviceToHost);
+    double average_distance = runBatches(d_x_walks, d_y_walks, x_walks, y_walks, true, streams, num_walks, num_steps, seed, threadsPerBlock);
 
-    double average_distance = calculateAverageDistance(x_walks, y_walks, num_walks);
+    for (int i = 0; i < 2; i++) {
+        // Free device memory
+        cudaFree(d_x_walks[i]);
+        cudaFree(d_y_walks[i]);
 
-    // Free device memory
-    cudaFree(d_x_walks);
-    cudaFree(d_y_walks);
-
-    // Free pinned memory on the host
-    cudaFreeHost(x_walks);
-    cudaFreeHost(y_walks);
+        // Free pinned memory on the host
+        cudaFreeHost(x_walks[i]);
+        cudaFreeHost(y_walks[i]);
+        cudaStreamDestroy(streams[i]);
+    }
 
     return average_distance;
 }
 
 // Allocate memory and perform random walks using unified CUDA memory allocation
-double unifiedMemoryAllocation(int num_walks, int num_steps, unsigned int seed, int threadsPerBlock, int blocksPerGrid) {
-    
-    int* x_walks;
-    int* y_walks;
-
-    // Allocate unified memory for x and y coordinates
-    cudaMallocManaged((void**)&x_walks, num_walks * num_steps * sizeof(int));
-    cudaMallocManaged((void**)&y_walks, num_walks * num_steps * sizeof(int));
-
-    // Launch the random walk kernel
-    random_walks<<<blocksPerGrid, threadsPerBlock>>>(x_walks, y_walks, num_walks, num_steps, seed);
-
-    // Ensure that the kernel has finished executing
-    cudaDeviceSynchronize();
+double unifiedMemoryAllocation(long long num_walks, int num_steps, unsigned int seed, int threadsPerBlock) {
+
+    int capacity = batchSize(num_walks, 0);
+    int* x_walks[2];
+    int* y_walks[2];
+    cudaStream_t streams[2];
+
+    for (int i = 0; i < 2; i++) {
+        // Allocate unified memory for one batch of endpoints (not num_walks * num_steps: only endpoints are stored)
+        cudaMallocManaged((void**)&x_walks[i], capacity * sizeof(int));
+        cudaMallocManaged((void**)&y_walks[i], capacity * sizeof(int));
+        cudaStreamCreate(&streams[i]);
+
+        // Tie each buffer to its stream so the host may read it while the other stream's kernel runs
+        cudaStreamAttachMemAsync(streams[i], x_walks[i], 0, cudaMemAttachSingle);
+        cudaStreamAttachMemAsync(streams[i], y_walks[i], 0, cudaMemAttachSingle);
+    }
 
-    double average_distance = calculateAverageDistance(x_walks, y_walks, num_walks);
+    double average_distance = runBatches(x_walks, y_walks, x_walks, y_walks, false, streams, num_walks, num_steps, seed, threadsPerBlock);
 
     // Free unified memory (no need to differentiate between host and device)
-    cudaFree(x_walks);
-    cudaFree(y_walks);
+    for (int i = 0; i < 2; i++) {
+        cudaFree(x_walks[i]);
+        cudaFree(y_walks[i]);
+        cudaStreamDestroy(streams[i]);
+    }
 
     return average_distance;
 }
 
 int main(int argc, char* argv[]) {
     unsigned int seed = time(NULL);
-    int numWalkers = 0;
+    long long numWalkers = 0;
     int totalSteps = 0;
 
     std::string programName = argv[0];
@@ -151,7 +206,7 @@ int main(int argc, char* argv[]) {
 
     for (size_t i = 0; i < arguments.size(); i++) {
         if (arguments[i] == "-W" && i + 1 < arguments.size()) {
-            numWalkers = std::stoi(arguments[i + 1]);
+            numWalkers = std::stoll(arguments[i + 1]);
         } else if (arguments[i] == "-I" && i + 1 < arguments.size()) {
             totalSteps = std::stoi(arguments[i + 1]);
         } else if (arguments[i] == "-H") {
@@ -170,16 +225,15 @@ int main(int argc, char* argv[]) {
 
     //std::cout << "Number of Walkers: " << numWalkers << ", Total Steps: " << totalSteps << std::endl;
 
-    // Set the number of threads per block and the number of blocks
+    // Set the number of threads per block; the blocks per grid follow from each batch
     int threadsPerBlock = 256;
-    int blocksPerGrid = (numWalkers + threadsPerBlock - 1) / threadsPerBlock;
 
     //Warmup time 
-    auto warmup_avg_time = normalMemoryAllocation(numWalkers, totalSteps, seed, threadsPerBlock, blocksPerGrid);
+    auto warmup_avg_time = normalMemoryAllocation(numWalkers, totalSteps, seed, threadsPerBlock);
 
     // Timer for normal memory allocation
     auto start = std::chrono::high_resolution_clock::now();
-    auto normal_avg_time = normalMemoryAllocation(numWalkers, totalSteps, seed, threadsPerBlock, blocksPerGrid);
+    auto normal_avg_time = normalMemoryAllocation(numWalkers, totalSteps, seed, threadsPerBlock);
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::microseconds elapsed = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
 
@@ -190,7 +244,7 @@ int main(int argc, char* argv[]) {
 
     // Timer for pinned memory allocation
     start = std::chrono::high_resolution_clock::now();
-    auto pinned_avg_time = pinnedMemoryAllocation(numWalkers, totalSteps, seed, threadsPerBlock, blocksPerGrid);
+    auto pinned_avg_time = pinnedMemoryAllocation(numWalkers, totalSteps, seed, threadsPerBlock);
     end = std::chrono::high_resolution_clock::now();
     elapsed = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
 
@@ -201,7 +255,7 @@ int main(int argc, char* argv[]) {
 
     // Timer for unified memory allocation
     start = std::chrono::high_resolution_clock::now();
-    auto unified_avg_time = unifiedMemoryAllocation(numWalkers, totalSteps, seed, threadsPerBlock, blocksPerGrid);
+    auto unified_avg_time = unifiedMemoryAllocation(numWalkers, totalSteps, seed, threadsPerBlock);
     end = std::chrono::high_resolution_clock::now();
     elapsed = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
 
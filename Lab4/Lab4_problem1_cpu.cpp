@@ -0,0 +1,287 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: CPU backend for the 2D random-walk simulator of Lab4_problem1.cu, for hosts without a GPU.
+Takes the same -W and -I options and reports the same three timings, with the CUDA memory strategies
+replaced by their host equivalents:
+    Normal  -> heap buffers (malloc)
+    Pinned  -> page-locked buffers (mmap + mlock)
+    Managed -> demand-paged buffers (mmap, first touched by the worker threads)
+Walkers are processed in batches through two reusable buffer sets, so -W can be far larger than memory.
+Walkers use counter-based Philox streams keyed on (seed, walker), so a given -S seed gives the same
+result for any thread count. -M replaces the step-by-step walk with exact multinomial sampling of the
+step counts (O(1) per walker), and -V checks that mode statistically against the step-by-step walk.
+Besides the average distance, the run reports the distance moments and quantiles; -O writes the 2D endpoint
+occupancy histogram as CSV. -R records every trajectory (2 bits per step) to a memory-mapped file and
+reports MSD(t), the velocity autocorrelation and returns to the origin instead of the timings.
+
+Build: g++ -std=c++14 -O3 -march=native -fopenmp-simd -pthread Lab4_problem1_cpu.cpp -o random_walk_cpu
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+#include <ctime>
+#include <cmath>
+#include <fstream>
+
+#include "ECE_RandomWalk.h"
+#include "ECE_HostMemory.h"
+#include "ECE_Trajectory.h"
+
+// Perform random walks through batch buffers allocated under the given host policy
+WalkStatistics runWithHostPolicy(HostPolicy policy, long long num_walks, int num_steps, unsigned int seed, int numThreads, WalkMethod method) {
+
+    int capacity = batchCapacity(num_walks);
+    HostBuffer storage(policy, 4 * static_cast<size_t>(capacity) * sizeof(int));
+    if (!storage.valid()) {
+        std::cerr << "[ERROR] " << hostPolicyName(policy) << " allocation failed: " << storage.getNote() << std::endl;
+        return WalkStatistics(num_steps, numThreads);
+    }
+    if (!storage.getNote().empty()) {
+        std::cerr << "[WARNING] " << storage.getNote() << std::endl;
+    }
+
+    int* base = static_cast<int*>(storage.get());
+    WalkBuffers buffers = {{base, base + capacity}, {base + 2 * capacity, base + 3 * capacity}, capacity};
+    return runWalkerBatches(buffers, num_walks, num_steps, seed, numThreads, method);
+}
+
+// Perform random walks through heap batch buffers
+WalkStatistics normalMemoryAllocation(long long num_walks, int num_steps, unsigned int seed, int numThreads, WalkMethod method) {
+    return runWithHostPolicy(HostPolicy::Heap, num_walks, num_steps, seed, numThreads, method);
+}
+
+// Perform random walks through page-locked batch buffers
+WalkStatistics pinnedMemoryAllocation(long long num_walks, int num_steps, unsigned int seed, int numThreads, WalkMethod method) {
+    return runWithHostPolicy(HostPolicy::Locked, num_walks, num_steps, seed, numThreads, method);
+}
+
+// Perform random walks through demand-paged batch buffers that the workers fault in themselves
+WalkStatistics unifiedMemoryAllocation(long long num_walks, int num_steps, unsigned int seed, int numThreads, WalkMethod method) {
+    return runWithHostPolicy(HostPolicy::DemandPaged, num_walks, num_steps, seed, numThreads, method);
+}
+
+// Compare the multinomial endpoints with step-by-step endpoints of the same walkers: a two-sample chi-square
+// test on binned x and y, the mean of r^2 against its exact value n, and the mean distances in standard errors
+bool validateMultinomialSampling(int num_walks, int num_steps, unsigned int seed, int numThreads) {
+    std::vector<int> stepX(num_walks), stepY(num_walks), sampleX(num_walks), sampleY(num_walks);
+    runRandomWalks(stepX.data(), stepY.data(), num_walks, num_steps, seed, numThreads, WalkMethod::StepByStep);
+    runRandomWalks(sampleX.data(), sampleY.data(), num_walks, num_steps, seed, numThreads, WalkMethod::Multinomial);
+
+    // Each coordinate has variance n / 2; 40 bins over +-4 sigma, the outermost bins collect the tails
+    const int numBins = 40;
+    double sigma = std::sqrt(num_steps / 2.0);
+    auto binOf = [&](int value) {
+        int bin = static_cast<int>(std::floor((value / sigma + 4.0) * numBins / 8.0));
+        return std::min(numBins - 1, std::max(0, bin));
+    };
+    std::vector<double> stepCounts(2 * numBins, 0.0), sampleCounts(2 * numBins, 0.0);
+
+    double stepR2 = 0.0, sampleR2 = 0.0;
+    double stepD = 0.0, sampleD = 0.0;
+    for (int i = 0; i < num_walks; ++i) {
+        stepCounts[binOf(stepX[i])] += 1.0;
+        stepCounts[numBins + binOf(stepY[i])] += 1.0;
+        sampleCounts[binOf(sampleX[i])] += 1.0;
+        sampleCounts[numBins + binOf(sampleY[i])] += 1.0;
+
+        double r2 = static_cast<double>(stepX[i]) * stepX[i] + static_cast<double>(stepY[i]) * stepY[i];
+        stepR2 += r2;
+        stepD += std::sqrt(r2);
+        r2 = static_cast<double>(sampleX[i]) * sampleX[i] + static_cast<double>(sampleY[i]) * sampleY[i];
+        sampleR2 += r2;
+        sampleD += std::sqrt(r2);
+    }
+
+    // Equal sample sizes: chi2 = sum (a - b)^2 / (a + b) over occupied bins, dof = bins - 2 (one per coordinate)
+    double chi2 = 0.0;
+    int occupied = 0;
+    for (int b = 0; b < 2 * numBins; ++b) {
+        double total = stepCounts[b] + sampleCounts[b];
+        if (total > 0.0) {
+            chi2 += (stepCounts[b] - sampleCounts[b]) * (stepCounts[b] - sampleCounts[b]) / total;
+            ++occupied;
+        }
+    }
+    int dof = std::max(1, occupied - 2);
+    // Wilson-Hilferty: (chi2 / dof)^(1/3) is close to normal
+    double chi2Z = (std::cbrt(chi2 / dof) - (1.0 - 2.0 / (9.0 * dof))) / std::sqrt(2.0 / (9.0 * dof));
+
+    double meanStep = stepD / num_walks, meanSample = sampleD / num_walks;
+    double varStep = stepR2 / num_walks - meanStep * meanStep;
+    double varSample = sampleR2 / num_walks - meanSample * meanSample;
+    double meanZ = (meanSample - meanStep) / std::sqrt((varStep + varSample) / num_walks);
+
+    std::cout << "Multinomial sampling validation (" << num_walks << " walkers, " << num_steps << " steps):" << std::endl;
+    std::cout << "    Chi-square of binned endpoints: " << chi2 << " (" << dof << " dof, z = " << chi2Z << ")" << std::endl;
+    std::cout << "    Mean r^2 step-by-step / multinomial / exact: " << stepR2 / num_walks << " / " << sampleR2 / num_walks << " / " << num_steps << std::endl;
+    std::cout << "    Mean distance step-by-step / multinomial: " << meanStep << " / " << meanSample << " (z = " << meanZ << ")" << std::endl;
+
+    bool passed = std::fabs(chi2Z) < 4.0 && std::fabs(meanZ) < 4.0;
+    std::cout << "    " << (passed ? "PASS" : "FAIL") << std::endl;
+    return passed;
+}
+
+// Print the distance moments and quantiles of a run
+void printDistanceStatistics(const WalkStatistics& statistics) {
+    const MomentAccumulator& moments = statistics.getMoments();
+    std::cout << "Distance statistics (" << statistics.getCount() << " walkers):" << std::endl;
+    std::cout << "    Mean: " << moments.mean << ", standard deviation: " << std::sqrt(moments.variance()) << std::endl;
+    std::cout << "    Skewness: " << moments.skewness() << ", excess kurtosis: " << moments.excessKurtosis() << std::endl;
+    std::cout << "    Quantiles (50%, 90%, 99%): " << statistics.distanceQuantile(0.5) << ", " << statistics.distanceQuantile(0.9)
+              << ", " << statistics.distanceQuantile(0.99) << std::endl;
+}
+
+// Write the 2D endpoint occupancy histogram as CSV rows (bin centre x, bin centre y, count)
+bool writeOccupancy(const WalkStatistics& statistics, const std::string& path) {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    uint64_t outside;
+    std::vector<uint64_t> counts = statistics.occupancy(outside);
+    double binWidth = 2.0 * statistics.getOccupancyHalfWidth() / OCCUPANCY_BINS;
+    file << "x,y,count" << std::endl;
+    for (int row = 0; row < OCCUPANCY_BINS; ++row) {
+        for (int column = 0; column < OCCUPANCY_BINS; ++column) {
+            file << (column + 0.5) * binWidth - statistics.getOccupancyHalfWidth() << ","
+                 << (row + 0.5) * binWidth - statistics.getOccupancyHalfWidth() << ","
+                 << counts[row * OCCUPANCY_BINS + column] << std::endl;
+        }
+    }
+    file << "# outside window: " << outside << std::endl;
+    return static_cast<bool>(file);
+}
+
+// Record all trajectories and print the time-resolved statistics
+bool runTrajectoryRecording(const std::string& path, long long num_walks, int num_steps, unsigned int seed, int numThreads) {
+    auto start = std::chrono::high_resolution_clock::now();
+    TrajectoryResult result = recordTrajectories(path, num_walks, num_steps, seed, numThreads, BATCH_WALKERS);
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!result.ok) {
+        std::cerr << "[ERROR] Could not record trajectories to " << path << std::endl;
+        return false;
+    }
+
+    std::cout << "Trajectory recording (" << num_walks << " walkers, " << num_steps << " steps) -> " << path << std::endl;
+    std::cout << "    Time to calculate(microsec): " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << std::endl;
+    std::cout << "    Mean squared displacement:" << std::endl;
+    std::cout << "    " << std::setw(12) << "t" << std::setw(16) << "MSD(t)" << std::setw(12) << "MSD(t)/t" << std::endl;
+    for (size_t k = 0; k < result.checkpoints.size(); ++k) {
+        std::cout << "    " << std::setw(12) << result.checkpoints[k] << std::setw(16) << result.msd[k]
+                  << std::setw(12) << result.msd[k] / result.checkpoints[k] << std::endl;
+    }
+    std::cout << "    Velocity autocorrelation:";
+    for (int l = 0; l < NUM_VACF_LAGS; ++l) {
+        std::cout << " C(" << VACF_LAGS[l] << ") = " << result.vacf[l] << (l + 1 < NUM_VACF_LAGS ? "," : "");
+    }
+    std::cout << std::endl;
+    std::cout << "    Returns to origin per walker: " << result.returnsPerWalker
+              << ", walkers that returned: " << result.returnFraction * 100.0 << "%" << std::endl;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    unsigned int seed = time(NULL);
+    long long numWalkers = 0;
+    int totalSteps = 0;
+    int numThreads = std::max(1u, std::thread::hardware_concurrency());
+    WalkMethod method = WalkMethod::StepByStep;
+    bool validate = false;
+    std::string occupancyPath;
+    std::string trajectoryPath;
+
+    std::string programName = argv[0];
+    std::vector<std::string> arguments(argv + 1, argv + argc);
+
+    for (size_t i = 0; i < arguments.size(); i++) {
+        if (arguments[i] == "-W" && i + 1 < arguments.size()) {
+            numWalkers = std::stoll(arguments[i + 1]);
+        } else if (arguments[i] == "-I" && i + 1 < arguments.size()) {
+            totalSteps = std::stoi(arguments[i + 1]);
+        } else if (arguments[i] == "-S" && i + 1 < arguments.size()) {
+            seed = static_cast<unsigned int>(std::stoul(arguments[i + 1]));
+        } else if (arguments[i] == "-T" && i + 1 < arguments.size()) {
+            numThreads = std::max(1, std::stoi(arguments[i + 1]));
+        } else if (arguments[i] == "-M") {
+            method = WalkMethod::Multinomial;
+        } else if (arguments[i] == "-O" && i + 1 < arguments.size()) {
+            occupancyPath = arguments[i + 1];
+        } else if (arguments[i] == "-R" && i + 1 < arguments.size()) {
+            trajectoryPath = arguments[i + 1];
+        } else if (arguments[i] == "-V") {
+            validate = true;
+        } else if (arguments[i] == "-H") {
+            std::cerr << "Usage: " << programName << " [-W <numWalkers>] [-I <totalSteps>] [-S <seed>] [-T <threads>] [-M] [-V] [-O <histogram.csv>] [-R <trajectories.bin>] [-H]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Set default values if no input was given
+    if (numWalkers <= 0) {
+        numWalkers = 1000;
+    }
+    if (totalSteps <= 0) {
+        totalSteps = 10000;
+    }
+
+    if (validate) {
+        // Validation keeps both endpoint sets in memory, so it is limited to one batch
+        return validateMultinomialSampling(batchCapacity(numWalkers), totalSteps, seed, numThreads) ? 0 : 1;
+    }
+
+    if (!trajectoryPath.empty()) {
+        return runTrajectoryRecording(trajectoryPath, numWalkers, totalSteps, seed, numThreads) ? 0 : 1;
+    }
+
+    //Warmup time
+    auto warmup_avg_time = normalMemoryAllocation(numWalkers, totalSteps, seed, numThreads, method);
+    (void)warmup_avg_time;
+
+    // Timer for heap allocation
+    auto start = std::chrono::high_resolution_clock::now();
+    auto normal_avg_time = normalMemoryAllocation(numWalkers, totalSteps, seed, numThreads, method);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::microseconds elapsed = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    // Output for heap allocation
+    std::cout << "Normal (heap) CPU memory Allocation:" << std::endl;
+    std::cout << std::setw(4) << "    Time to calculate(microsec): " << elapsed.count() << std::endl;
+    std::cout << std::setw(4) << "    Average distance from origin: " << normal_avg_time.averageDistance() << std::endl;
+
+    // Timer for page-locked allocation
+    start = std::chrono::high_resolution_clock::now();
+    auto pinned_avg_time = pinnedMemoryAllocation(numWalkers, totalSteps, seed, numThreads, method);
+    end = std::chrono::high_resolution_clock::now();
+    elapsed = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    // Output for page-locked allocation
+    std::cout << "Pinned (mlock) CPU memory Allocation:" << std::endl;
+    std::cout << std::setw(4) << "    Time to calculate(microsec): " << elapsed.count() << std::endl;
+    std::cout << std::setw(4) << "    Average distance from origin: " << pinned_avg_time.averageDistance() << std::endl;
+
+    // Timer for demand-paged allocation
+    start = std::chrono::high_resolution_clock::now();
+    auto unified_avg_time = unifiedMemoryAllocation(numWalkers, totalSteps, seed, numThreads, method);
+    end = std::chrono::high_resolution_clock::now();
+    elapsed = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    // Output for demand-paged allocation
+    std::cout << "Managed (demand-paged) CPU memory Allocation:" << std::endl;
+    std::cout << std::setw(4) << "    Time to calculate(microsec): " << elapsed.count() << std::endl;
+    std::cout << std::setw(4) << "    Average distance from origin: " << unified_avg_time.averageDistance() << std::endl;
+
+    printDistanceStatistics(normal_avg_time);
+    if (!occupancyPath.empty() && !writeOccupancy(normal_avg_time, occupancyPath)) {
+        std::cerr << "[ERROR] Could not write " << occupancyPath << std::endl;
+    }
+
+    std::cout << "Bye" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,415 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 10/18/2026
+Description: Long-running TCP service for the Lab1 electric field solver. Clients register
+a charge grid once and then stream probe points; the server keeps the charge sets resident,
+batches pending probe requests into multi-point evaluations and replies asynchronously.
+
+Protocol (tcpMessage framing from ServerTCP, nVersion 102):
+    nType 110  "N M xSep ySep q"        register a grid, reply 110 "<setId>"
+    nType 111  "setId x y z[;x y z...]" probe points, reply 112 "Ex Ey Ez[;Ex Ey Ez...]", split over as many
+                                        112 messages as needed, each holding whole points in order
+    nType 113  "setId"                  release a grid, reply 113 "<setId>"
+    nType 255  error text sent back for malformed requests
+*/
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <SFML/Network.hpp>
+#include <cstring>
+#include <cstdio>
+#include <atomic>
+#include <algorithm>
+
+#include "ECE_ElectricField.h"
+#include "ECE_ElectricFieldUtils.h"
+
+const unsigned char PROTOCOL_VERSION = 102;
+const unsigned char MSG_REGISTER = 110;
+const unsigned char MSG_PROBE = 111;
+const unsigned char MSG_RESULT = 112;
+const unsigned char MSG_RELEASE = 113;
+const unsigned char MSG_ERROR = 255;
+
+// Below this many charge-probe pairs a batch is evaluated on the batching thread itself
+const size_t PARALLEL_BATCH_WORK = 1 << 16;
+// Longest reply text: chMsg less its terminating zero
+const size_t MAX_REPLY_TEXT = 999;
+// Largest N x M grid a client may register, so one request cannot exhaust the server's memory
+const long long MAX_CHARGES_PER_SET = 1 << 22;
+
+std::atomic<bool> serverRunning(true);
+std::vector<std::thread> clientThreads;
+
+struct tcpMessage {
+    unsigned char nVersion;
+    unsigned char nType;
+    unsigned short nMsgLen;
+    char chMsg[1000];
+};
+
+// A connected client; shared so a reply in flight keeps the socket alive after the client thread drops it
+struct ClientInfo {
+    sf::TcpSocket socket;
+    std::mutex sendMutex;
+    bool connected = true;      // Cleared under sendMutex when the client thread disconnects the socket
+};
+
+std::vector<std::shared_ptr<ClientInfo>> clients;
+std::mutex clientsMutex;
+
+// A charge grid kept resident between queries
+struct ChargeSet {
+    int N;
+    int M;
+    std::vector<Point3D> grid;
+    std::vector<ECE_ElectricField> charges;
+};
+
+std::map<int, std::shared_ptr<const ChargeSet>> chargeSets;
+std::mutex chargeSetsMutex;
+int nextChargeSetId = 1;
+
+// A probe request waiting for the batching thread
+struct ProbeRequest {
+    std::weak_ptr<ClientInfo> client;       // Replies are dropped if the client has gone by then
+    std::shared_ptr<const ChargeSet> chargeSet;
+    std::vector<Point3D> points;
+};
+
+std::deque<ProbeRequest> pendingRequests;
+std::mutex requestMutex;
+std::condition_variable requestCondition;
+
+sf::Socket::Status sendComplete(sf::TcpSocket& socket, const void* data, size_t size) {
+    const char* dataPtr = static_cast<const char*>(data);
+    size_t totalSent = 0;
+
+    while (totalSent < size) {
+        std::size_t sent;
+        sf::Socket::Status status = socket.send(dataPtr + totalSent, size - totalSent, sent);
+        if (status != sf::Socket::Done && status != sf::Socket::Partial) {
+            return status;  // Return on any error
+        }
+        totalSent += sent;
+    }
+
+    return sf::Socket::Done;
+}
+
+// Send a reply of at most MAX_REPLY_TEXT characters to a client if it is still connected. Only the client's own
+// send lock is held while sending, so a slow client does not stall replies to the others.
+void sendReply(const std::shared_ptr<ClientInfo>& client, unsigned char type, const std::string& text) {
+    tcpMessage outMsg;
+    outMsg.nVersion = PROTOCOL_VERSION;
+    outMsg.nType = type;
+    outMsg.nMsgLen = static_cast<unsigned short>(std::min(text.size(), MAX_REPLY_TEXT));
+    std::memset(outMsg.chMsg, 0, sizeof(outMsg.chMsg));
+    std::memcpy(outMsg.chMsg, text.c_str(), outMsg.nMsgLen);
+
+    if (client) {
+        std::lock_guard<std::mutex> sendLock(client->sendMutex);
+        if (client->connected) {
+            sendComplete(client->socket, &outMsg, sizeof(outMsg));
+        }
+    }
+}
+
+// Send probe results as type 112 messages, starting a new message whenever the next point would not fit
+void sendResults(const std::shared_ptr<ClientInfo>& client, const std::vector<ThreadResult>& results, size_t first, size_t count) {
+    std::string reply;
+    char pointText[128];
+    for (size_t p = first; p < first + count; ++p) {
+        int length = std::snprintf(pointText, sizeof(pointText), "%e %e %e", results[p].Ex, results[p].Ey, results[p].Ez);
+        if (!reply.empty() && reply.size() + 1 + length > MAX_REPLY_TEXT) {
+            sendReply(client, MSG_RESULT, reply);
+            reply.clear();
+        }
+        if (!reply.empty()) {
+            reply += ';';
+        }
+        reply.append(pointText, length);
+    }
+    sendReply(client, MSG_RESULT, reply);
+}
+
+// Parse "N M xSep ySep q" and build a resident charge set of at most MAX_CHARGES_PER_SET charges
+bool registerChargeSet(const std::string& text, int& setId) {
+    std::istringstream stream(text);
+    int N = 0, M = 0;
+    double xSeparation = 0.0, ySeparation = 0.0, chargeVal = 0.0;
+    if (!(stream >> N >> M >> xSeparation >> ySeparation >> chargeVal)) {
+        return false;
+    }
+    if (N <= 0 || M <= 0 || xSeparation <= 0.0 || ySeparation <= 0.0 || chargeVal <= 0.0) {
+        return false;
+    }
+    if (static_cast<long long>(N) * M > MAX_CHARGES_PER_SET) {
+        return false;
+    }
+
+    auto chargeSet = std::make_shared<ChargeSet>();
+    chargeSet->N = N;
+    chargeSet->M = M;
+    chargeSet->grid = calculateGridCoordinates(N, M, xSeparation, ySeparation);
+    chargeSet->charges.reserve(chargeSet->grid.size());
+    for (const auto& point : chargeSet->grid) {
+        chargeSet->charges.emplace_back(point.x, point.y, point.z, chargeVal);
+    }
+
+    std::lock_guard<std::mutex> lock(chargeSetsMutex);
+    setId = nextChargeSetId++;
+    chargeSets[setId] = chargeSet;
+    return true;
+}
+
+// Parse "setId x y z[;x y z...]" into a probe request
+bool parseProbeRequest(const std::string& text, ProbeRequest& request) {
+    std::istringstream stream(text);
+    int setId = 0;
+    if (!(stream >> setId)) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(chargeSetsMutex);
+        auto it = chargeSets.find(setId);
+        if (it == chargeSets.end()) {
+            return false;
+        }
+        request.chargeSet = it->second;
+    }
+
+    std::string pointText;
+    while (std::getline(stream, pointText, ';')) {
+        std::istringstream pointStream(pointText);
+        Point3D point;
+        if (!(pointStream >> point.x >> point.y >> point.z)) {
+            return false;
+        }
+        request.points.push_back(point);
+    }
+
+    return !request.points.empty();
+}
+
+// Accumulate the field of charges [startIdx, endIdx) at every probe point
+void evaluateChargeRange(const ChargeSet& chargeSet, const std::vector<Point3D>& points, int startIdx, int endIdx, std::vector<ThreadResult>& partialResult) {
+    for (int i = startIdx; i < endIdx; ++i) {
+        const ECE_ElectricField& charge = chargeSet.charges[i];
+        for (size_t p = 0; p < points.size(); ++p) {
+            charge.addFieldAt(points[p].x, points[p].y, points[p].z, partialResult[p].Ex, partialResult[p].Ey, partialResult[p].Ez);
+        }
+    }
+}
+
+// Evaluate all probe points of one charge set in a single pass over its charges
+std::vector<ThreadResult> evaluateBatch(const ChargeSet& chargeSet, const std::vector<Point3D>& points) {
+    int numCharges = static_cast<int>(chargeSet.charges.size());
+    std::vector<ThreadResult> results(points.size(), ThreadResult{0.0, 0.0, 0.0});
+
+    if (static_cast<size_t>(numCharges) * points.size() < PARALLEL_BATCH_WORK) {
+        evaluateChargeRange(chargeSet, points, 0, numCharges, results);
+        return results;
+    }
+
+    int numThreads = std::max(1u, std::thread::hardware_concurrency());
+    auto threadRanges = calculateDataDistribution(numCharges, numThreads);
+    std::vector<std::vector<ThreadResult>> partialResults(threadRanges.size(), results);
+    std::vector<std::thread> threads(threadRanges.size());
+
+    for (size_t i = 0; i < threadRanges.size(); ++i) {
+        threads[i] = std::thread(evaluateChargeRange, std::cref(chargeSet), std::cref(points),
+                                 threadRanges[i].start, threadRanges[i].end, std::ref(partialResults[i]));
+    }
+
+    for (size_t i = 0; i < threads.size(); ++i) {
+        threads[i].join();
+        for (size_t p = 0; p < points.size(); ++p) {
+            results[p].Ex += partialResults[i][p].Ex;
+            results[p].Ey += partialResults[i][p].Ey;
+            results[p].Ez += partialResults[i][p].Ez;
+        }
+    }
+
+    return results;
+}
+
+// Drains the request queue, merges requests against the same charge set and replies to each client
+void batchProbeRequests() {
+    while (true) {
+        std::deque<ProbeRequest> batch;
+        {
+            std::unique_lock<std::mutex> lock(requestMutex);
+            requestCondition.wait(lock, []() { return !pendingRequests.empty() || !serverRunning; });
+            if (!serverRunning && pendingRequests.empty()) {
+                return;
+            }
+            batch.swap(pendingRequests);
+        }
+
+        while (!batch.empty()) {
+            // Gather every queued request that shares the first request's charge set
+            auto chargeSet = batch.front().chargeSet;
+            std::vector<Point3D> points;
+            std::vector<ProbeRequest> group;
+            for (auto it = batch.begin(); it != batch.end();) {
+                if (it->chargeSet == chargeSet) {
+                    points.insert(points.end(), it->points.begin(), it->points.end());
+                    group.push_back(std::move(*it));
+                    it = batch.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+
+            auto results = evaluateBatch(*chargeSet, points);
+
+            size_t offset = 0;
+            for (const auto& request : group) {
+                sendResults(request.client.lock(), results, offset, request.points.size());
+                offset += request.points.size();
+            }
+        }
+    }
+}
+
+void handleClient(std::shared_ptr<ClientInfo> client) {
+    if (!client) return;
+
+    sf::TcpSocket* clientSocket = &client->socket;
+    sf::SocketSelector selector;
+    selector.add(*clientSocket);
+
+    while (serverRunning) {
+        if (selector.wait(sf::milliseconds(100))) {
+            tcpMessage inMsg;
+            std::size_t received;
+            sf::Socket::Status status = clientSocket->receive(&inMsg, sizeof(inMsg), received);
+
+            if (status == sf::Socket::Done) {
+                if (inMsg.nVersion != PROTOCOL_VERSION) {
+                    continue;
+                }
+                std::string text(inMsg.chMsg, std::min<size_t>(inMsg.nMsgLen, sizeof(inMsg.chMsg)));
+
+                if (inMsg.nType == MSG_REGISTER) {
+                    int setId = 0;
+                    if (registerChargeSet(text, setId)) {
+                        sendReply(client, MSG_REGISTER, std::to_string(setId));
+                    } else {
+                        sendReply(client, MSG_ERROR, "Expected: N M xSep ySep q (all > 0, N x M at most " + std::to_string(MAX_CHARGES_PER_SET) + ")");
+                    }
+                } else if (inMsg.nType == MSG_PROBE) {
+                    ProbeRequest request;
+                    request.client = client;
+                    if (parseProbeRequest(text, request)) {
+                        {
+                            std::lock_guard<std::mutex> lock(requestMutex);
+                            pendingRequests.push_back(std::move(request));
+                        }
+                        requestCondition.notify_one();
+                    } else {
+                        sendReply(client, MSG_ERROR, "Expected: setId x y z[;x y z...] for a registered set");
+                    }
+                } else if (inMsg.nType == MSG_RELEASE) {
+                    int setId = std::atoi(text.c_str());
+                    size_t released;
+                    {
+                        std::lock_guard<std::mutex> lock(chargeSetsMutex);
+                        released = chargeSets.erase(setId);
+                    }
+                    if (released > 0) {
+                        sendReply(client, MSG_RELEASE, std::to_string(setId));
+                    } else {
+                        sendReply(client, MSG_ERROR, "No registered set " + std::to_string(setId));
+                    }
+                }
+            } else if (status == sf::Socket::Disconnected) {
+                break; // Exit loop if client is disconnected
+            }
+        }
+    }
+
+    // The batching thread may still hold the client for a reply; the socket lives until both have let go,
+    // and replies still queued for it are dropped rather than sent to a later connection
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        clients.erase(std::remove(clients.begin(), clients.end(), client), clients.end());
+    }
+    std::lock_guard<std::mutex> sendLock(client->sendMutex);
+    client->connected = false;
+    client->socket.disconnect();
+}
+
+void acceptClients(sf::TcpListener& listener) {
+    listener.setBlocking(false);
+
+    while (serverRunning) {
+        auto client = std::make_shared<ClientInfo>();
+        if (listener.accept(client->socket) == sf::Socket::Done) {
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            clients.push_back(client);
+            clientThreads.push_back(std::thread(handleClient, client));
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+void runFieldServer(unsigned short port) {
+    sf::TcpListener listener;
+    if (listener.listen(port) != sf::Socket::Done) {
+        std::cerr << "Failed to listen on port " << port << std::endl;
+        return;
+    }
+
+    std::thread clientAcceptThread(acceptClients, std::ref(listener));
+    std::thread batchThread(batchProbeRequests);
+
+    std::string command;
+    while (true) {
+        std::cout << "Please enter command: ";
+        std::getline(std::cin, command);
+
+        if (command == "sets") {
+            std::lock_guard<std::mutex> lock(chargeSetsMutex);
+            std::cout << "Number of Charge Sets: " << chargeSets.size() << std::endl;
+            for (const auto& entry : chargeSets) {
+                std::cout << "Set " << entry.first << " | Grid: " << entry.second->N << " x " << entry.second->M << std::endl;
+            }
+        } else if (command == "clients") {
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            std::cout << "Number of Clients: " << clients.size() << std::endl;
+            for (const auto& client : clients) {
+                std::cout << "IP Address: " << client->socket.getRemoteAddress()
+                          << " | Port: " << client->socket.getRemotePort() << std::endl;
+            }
+        } else if (command == "exit" || !std::cin) {
+            serverRunning = false;
+            listener.close();
+            break;
+        }
+    }
+
+    requestCondition.notify_all();
+    batchThread.join();
+    clientAcceptThread.join();
+    for (auto& thread : clientThreads) {
+        if (thread.joinable()) thread.join();
+    }
+}
+
+int main() {
+    const unsigned short port = 50002;
+    runFieldServer(port);
+    return 0;
+}
@@ -0,0 +1,47 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Round schedule and stopping rule for sampling to a target error. Rounds double in size, but once
+there is an estimate each round is capped at the chunks it predicts are still needed. Every rank makes that
+choice from the same reduced totals, so where a run stops, and therefore its result, depends only on the seed
+and the targets. Round r + 1 is sampled while round r is reduced and is kept when round r meets the target, so
+a run overshoots the samples it needed by at most that one capped round (plus the error in the prediction).
+*/
+
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+
+constexpr long long ROUND_FIRST_CHUNKS = 16;     // Chunks in round 0; rounds double from here...
+constexpr long long ROUND_MAX_CHUNKS = 16384;    // ...up to this many chunks each (64M samples)
+constexpr int MIN_ROUNDS = 3;                    // Rounds before the variance estimate is trusted
+constexpr double CONFIDENCE_Z = 1.96;            // Half-width of a 95% confidence interval in standard errors
+constexpr double PROGRESS_SECONDS = 1.0;         // Minimum time between progress lines on rank 0
+constexpr int TEST_MICROSECONDS = 100;           // Pause between MPI_Test calls while a round is sampled
+
+// Number of chunks in round `round`
+inline long long roundChunks(int round) {
+    return std::min(ROUND_MAX_CHUNKS, ROUND_FIRST_CHUNKS << std::min(round, 20));
+}
+
+// True once the confidence interval is within the absolute or relative target (a target <= 0 is unset)
+inline bool targetReached(double value, double standardError, double absoluteTarget, double relativeTarget) {
+    double halfWidth = CONFIDENCE_Z * standardError;
+    return (absoluteTarget > 0.0 && halfWidth <= absoluteTarget) || (relativeTarget > 0.0 && halfWidth <= relativeTarget * std::fabs(value));
+}
+
+// Chunks still needed beyond `sampled` to bring the confidence interval within the target, given the estimate
+// over the first `reduced` chunks and a standard error shrinking as 1 / sqrt(chunks). Never fewer than
+// ROUND_FIRST_CHUNKS, so a run close to its target still finishes in one more round of useful size.
+inline long long chunksToTarget(long long reduced, long long sampled, double value, double standardError, double absoluteTarget,
+                                double relativeTarget) {
+    double target = std::max(absoluteTarget, relativeTarget * std::fabs(value));
+    if (target <= 0.0) {
+        return ROUND_MAX_CHUNKS;
+    }
+    double ratio = CONFIDENCE_Z * standardError / target;
+    double needed = std::min(1e15, std::ceil(reduced * ratio * ratio));
+    return std::max(ROUND_FIRST_CHUNKS, static_cast<long long>(needed) - sampled);
+}
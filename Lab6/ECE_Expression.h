@@ -0,0 +1,522 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Integrands written as expressions on the command line (-f "exp(-x0*x0-x1*x1)") instead of compiled
+in. An expression of the coordinates x0, x1, ... over the unit cube is compiled once, on rank 0, to register
+bytecode: every instruction applies one operation to whole slots of EXPRESSION_LANES points, so the dispatch
+cost is paid once per batch and the loop inside each opcode vectorises. The program serialises to a few bytes
+for MPI_Bcast.
+
+    expression:  comparison, where a < b, <=, >, >= give 1 or 0
+    sum:         term (+|- term)*
+    term:        unary (*|/ unary)*
+    unary:       -unary | power
+    power:       primary (^ unary)?           integer powers become multiplications
+    primary:     number | x<d> | pi | e | function(expression[, expression]) | (expression)
+    functions:   exp log sqrt sin cos tan abs, and pow min max of two arguments
+
+Constant subexpressions are folded while compiling.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cctype>
+#include <cstring>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "ECE_VectorMath.h"
+
+constexpr int EXPRESSION_LANES = 256;             // Points per slot
+constexpr int MAX_EXPRESSION_SLOTS = 1024;        // Inputs, constants and registers together
+constexpr int MAX_EXPRESSION_VARIABLES = 64;      // x0 to x63, the integrands' MAX_DIMENSION
+constexpr int MAX_INTEGER_POWER = 16;             // Larger integer exponents call std::pow
+
+enum ExpressionOpcode : uint8_t {
+    OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_POW, OP_MIN, OP_MAX,
+    OP_LESS, OP_LESS_EQUAL, OP_GREATER, OP_GREATER_EQUAL,
+    OP_NEG, OP_EXP, OP_LOG, OP_SQRT, OP_SIN, OP_COS, OP_TAN, OP_ABS
+};
+
+// slots[target] = op(slots[left], slots[right]); unary operations ignore right. Slots are numbered inputs
+// first, then constants, then registers.
+struct ExpressionInstruction {
+    uint8_t opcode;
+    uint8_t unused;
+    uint16_t target;
+    uint16_t left;
+    uint16_t right;
+};
+
+// out[i] = op(a[i], b[i]) for one instruction over count lanes
+inline void applyOpcode(int opcode, const double* a, const double* b, double* out, int count) {
+    switch (opcode) {
+    case OP_ADD:
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) out[i] = a[i] + b[i];
+        break;
+    case OP_SUB:
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) out[i] = a[i] - b[i];
+        break;
+    case OP_MUL:
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) out[i] = a[i] * b[i];
+        break;
+    case OP_DIV:
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) out[i] = a[i] / b[i];
+        break;
+    case OP_POW:
+        for (int i = 0; i < count; ++i) out[i] = std::pow(a[i], b[i]);
+        break;
+    case OP_MIN:
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) out[i] = std::min(a[i], b[i]);
+        break;
+    case OP_MAX:
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) out[i] = std::max(a[i], b[i]);
+        break;
+    case OP_LESS:
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) out[i] = (a[i] < b[i]) ? 1.0 : 0.0;
+        break;
+    case OP_LESS_EQUAL:
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) out[i] = (a[i] <= b[i]) ? 1.0 : 0.0;
+        break;
+    case OP_GREATER:
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) out[i] = (a[i] > b[i]) ? 1.0 : 0.0;
+        break;
+    case OP_GREATER_EQUAL:
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) out[i] = (a[i] >= b[i]) ? 1.0 : 0.0;
+        break;
+    case OP_NEG:
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) out[i] = -a[i];
+        break;
+    case OP_EXP:
+        simdExp(a, out, count);
+        break;
+    case OP_LOG:
+        for (int i = 0; i < count; ++i) out[i] = std::log(a[i]);
+        break;
+    case OP_SQRT:
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) out[i] = std::sqrt(a[i]);
+        break;
+    case OP_SIN:
+        for (int i = 0; i < count; ++i) out[i] = std::sin(a[i]);
+        break;
+    case OP_COS:
+        for (int i = 0; i < count; ++i) out[i] = std::cos(a[i]);
+        break;
+    case OP_TAN:
+        for (int i = 0; i < count; ++i) out[i] = std::tan(a[i]);
+        break;
+    case OP_ABS:
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) out[i] = std::fabs(a[i]);
+        break;
+    }
+}
+
+// A compiled expression: its bytecode, constant pool and register count
+struct ExpressionProgram {
+    int dimension = 1;            // Coordinates read: one more than the largest d of x<d>
+    int numRegisters = 0;
+    int result = 0;               // Slot holding the value once the instructions have run
+    std::vector<ExpressionInstruction> code;
+    std::vector<double> constants;
+
+    int numSlots() const { return dimension + static_cast<int>(constants.size()) + numRegisters; }
+
+    // out[i] = the expression at point i, x[d][i] being coordinate d; safe to call from several threads at once
+    void evaluate(const double* const* x, int count, double* out) const {
+        thread_local std::vector<double> workspace;
+        thread_local std::vector<const double*> slots;
+        int numConstants = static_cast<int>(constants.size());
+        workspace.resize((numConstants + numRegisters) * EXPRESSION_LANES);
+        slots.resize(numSlots());
+        for (int c = 0; c < numConstants; ++c) {
+            double* lanes = &workspace[c * EXPRESSION_LANES];
+            for (int i = 0; i < EXPRESSION_LANES; ++i) {
+                lanes[i] = constants[c];
+            }
+            slots[dimension + c] = lanes;
+        }
+        for (int r = 0; r < numRegisters; ++r) {
+            slots[dimension + numConstants + r] = &workspace[(numConstants + r) * EXPRESSION_LANES];
+        }
+
+        for (int first = 0; first < count; first += EXPRESSION_LANES) {
+            int lanes = std::min(EXPRESSION_LANES, count - first);
+            for (int d = 0; d < dimension; ++d) {
+                slots[d] = x[d] + first;
+            }
+            for (const ExpressionInstruction& instruction : code) {
+                applyOpcode(instruction.opcode, slots[instruction.left], slots[instruction.right],
+                            const_cast<double*>(slots[instruction.target]), lanes);
+            }
+            std::memcpy(out + first, slots[result], lanes * sizeof(double));
+        }
+    }
+
+    // Flatten to bytes for MPI_Bcast: four ints (dimension, registers, result, instruction count), the
+    // instructions and the constants
+    std::vector<char> serialise() const {
+        int header[4] = {dimension, numRegisters, result, static_cast<int>(code.size())};
+        size_t codeBytes = code.size() * sizeof(ExpressionInstruction);
+        std::vector<char> bytes(sizeof(header) + codeBytes + constants.size() * sizeof(double));
+        std::memcpy(bytes.data(), header, sizeof(header));
+        std::memcpy(bytes.data() + sizeof(header), code.data(), codeBytes);
+        std::memcpy(bytes.data() + sizeof(header) + codeBytes, constants.data(), constants.size() * sizeof(double));
+        return bytes;
+    }
+
+    bool deserialise(const std::vector<char>& bytes) {
+        int header[4];
+        if (bytes.size() < sizeof(header)) {
+            return false;
+        }
+        std::memcpy(header, bytes.data(), sizeof(header));
+        size_t codeBytes = static_cast<size_t>(header[3]) * sizeof(ExpressionInstruction);
+        if (header[3] < 0 || bytes.size() < sizeof(header) + codeBytes || (bytes.size() - sizeof(header) - codeBytes) % sizeof(double) != 0) {
+            return false;
+        }
+        dimension = header[0];
+        numRegisters = header[1];
+        result = header[2];
+        code.resize(header[3]);
+        constants.resize((bytes.size() - sizeof(header) - codeBytes) / sizeof(double));
+        std::memcpy(code.data(), bytes.data() + sizeof(header), codeBytes);
+        std::memcpy(constants.data(), bytes.data() + sizeof(header) + codeBytes, constants.size() * sizeof(double));
+        return true;
+    }
+};
+
+// Recursive descent compiler from expression text to an ExpressionProgram
+class ExpressionCompiler {
+public:
+    // Compile text into program; on failure returns false and describes the problem in error
+    bool compile(const std::string& text, ExpressionProgram& program, std::string& error) {
+        source = text;
+        position = 0;
+        message.clear();
+        instructions.clear();
+        constants.clear();
+        freeRegisters.clear();
+        numRegisters = 0;
+        numVariables = 1;
+
+        Value value = parseComparison();
+        skipSpaces();
+        if (message.empty() && position < source.size()) {
+            fail("unexpected '" + source.substr(position, 1) + "'");
+        }
+        int result = slotOf(value);
+        if (message.empty() && numVariables + static_cast<int>(constants.size()) + numRegisters > MAX_EXPRESSION_SLOTS) {
+            fail("expression too large");
+        }
+        if (!message.empty()) {
+            error = message;
+            return false;
+        }
+
+        // Number the slots now that the variables, constants and registers are all known
+        program.dimension = numVariables;
+        program.numRegisters = numRegisters;
+        program.constants = constants;
+        program.code.clear();
+        for (const Pending& pending : instructions) {
+            program.code.push_back(ExpressionInstruction{pending.opcode, 0, number(pending.target), number(pending.left), number(pending.right)});
+        }
+        program.result = number(result);
+        return true;
+    }
+
+private:
+    // Operand while compiling: a folded constant, an input coordinate or a register
+    enum Kind { CONSTANT, INPUT, REGISTER };
+    struct Value {
+        Kind kind;
+        double constant;
+        int index;
+    };
+    // Instruction with slots encoded as kind * MAX_EXPRESSION_SLOTS + index until the slots are numbered
+    struct Pending {
+        uint8_t opcode;
+        int target, left, right;
+    };
+
+    std::string source;
+    size_t position = 0;
+    std::string message;
+    std::vector<Pending> instructions;
+    std::vector<double> constants;
+    std::vector<int> freeRegisters;
+    int numRegisters = 0;
+    int numVariables = 1;
+
+    static Value constantValue(double constant) { return Value{CONSTANT, constant, 0}; }
+
+    void fail(const std::string& what) {
+        if (message.empty()) {
+            message = what + " at position " + std::to_string(position);
+        }
+    }
+
+    void skipSpaces() {
+        while (position < source.size() && std::isspace(static_cast<unsigned char>(source[position]))) {
+            ++position;
+        }
+    }
+
+    bool accept(const char* token) {
+        skipSpaces();
+        size_t length = std::strlen(token);
+        if (source.compare(position, length, token) == 0) {
+            position += length;
+            return true;
+        }
+        return false;
+    }
+
+    // Encoded slot of a value, pooling its constant if it is one
+    int slotOf(const Value& value) {
+        if (value.kind == CONSTANT) {
+            for (size_t c = 0; c < constants.size(); ++c) {
+                if (constants[c] == value.constant || (std::isnan(constants[c]) && std::isnan(value.constant))) {
+                    return CONSTANT * MAX_EXPRESSION_SLOTS + static_cast<int>(c);
+                }
+            }
+            constants.push_back(value.constant);
+            return CONSTANT * MAX_EXPRESSION_SLOTS + static_cast<int>(constants.size()) - 1;
+        }
+        return value.kind * MAX_EXPRESSION_SLOTS + value.index;
+    }
+
+    uint16_t number(int encoded) const {
+        int kind = encoded / MAX_EXPRESSION_SLOTS, index = encoded % MAX_EXPRESSION_SLOTS;
+        if (kind == INPUT) {
+            return static_cast<uint16_t>(index);
+        }
+        if (kind == CONSTANT) {
+            return static_cast<uint16_t>(numVariables + index);
+        }
+        return static_cast<uint16_t>(numVariables + static_cast<int>(constants.size()) + index);
+    }
+
+    // Value of op(left, right): folded if both are constants, otherwise an instruction writing a register. Operand
+    // registers are released (every lane only reads its own inputs, so the target may reuse one) except `kept`.
+    Value emit(uint8_t opcode, const Value& left, const Value& right, int kept = -1) {
+        if (left.kind == CONSTANT && right.kind == CONSTANT) {
+            double result = 0.0;
+            applyOpcode(opcode, &left.constant, &right.constant, &result, 1);
+            return constantValue(result);
+        }
+        int leftSlot = slotOf(left), rightSlot = slotOf(right);
+        if (left.kind == REGISTER && left.index != kept) {
+            freeRegisters.push_back(left.index);
+        }
+        if (right.kind == REGISTER && right.index != kept && !(left.kind == REGISTER && left.index == right.index)) {
+            freeRegisters.push_back(right.index);
+        }
+        int target;
+        if (freeRegisters.empty()) {
+            target = numRegisters++;
+        } else {
+            target = freeRegisters.back();
+            freeRegisters.pop_back();
+        }
+        instructions.push_back(Pending{opcode, REGISTER * MAX_EXPRESSION_SLOTS + target, leftSlot, rightSlot});
+        return Value{REGISTER, 0.0, target};
+    }
+
+    // base^n for an integer n, squaring and multiplying from the top bit of n down
+    Value integerPower(const Value& base, long n) {
+        bool inverse = n < 0;
+        n = std::labs(n);
+        if (n == 0) {
+            return constantValue(1.0);
+        }
+        int kept = (base.kind == REGISTER) ? base.index : -1;
+        int top = 0;
+        while ((n >> (top + 1)) != 0) {
+            ++top;
+        }
+        Value result = base;
+        for (int bit = top - 1; bit >= 0; --bit) {
+            result = emit(OP_MUL, result, result, kept);
+            if ((n >> bit) & 1) {
+                result = emit(OP_MUL, result, base, kept);
+            }
+        }
+        if (top > 0 && kept >= 0) {
+            freeRegisters.push_back(kept);
+        }
+        return inverse ? emit(OP_DIV, constantValue(1.0), result) : result;
+    }
+
+    Value parseComparison() {
+        Value left = parseSum();
+        while (message.empty()) {
+            if (accept("<=")) {
+                left = emit(OP_LESS_EQUAL, left, parseSum());
+            } else if (accept(">=")) {
+                left = emit(OP_GREATER_EQUAL, left, parseSum());
+            } else if (accept("<")) {
+                left = emit(OP_LESS, left, parseSum());
+            } else if (accept(">")) {
+                left = emit(OP_GREATER, left, parseSum());
+            } else {
+                break;
+            }
+        }
+        return left;
+    }
+
+    Value parseSum() {
+        Value left = parseTerm();
+        while (message.empty()) {
+            if (accept("+")) {
+                left = emit(OP_ADD, left, parseTerm());
+            } else if (accept("-")) {
+                left = emit(OP_SUB, left, parseTerm());
+            } else {
+                break;
+            }
+        }
+        return left;
+    }
+
+    Value parseTerm() {
+        Value left = parseUnary();
+        while (message.empty()) {
+            if (accept("*")) {
+                left = emit(OP_MUL, left, parseUnary());
+            } else if (accept("/")) {
+                left = emit(OP_DIV, left, parseUnary());
+            } else {
+                break;
+            }
+        }
+        return left;
+    }
+
+    Value parseUnary() {
+        if (accept("-")) {
+            Value operand = parseUnary();
+            return emit(OP_NEG, operand, operand);
+        }
+        if (accept("+")) {
+            return parseUnary();
+        }
+        return parsePower();
+    }
+
+    Value parsePower() {
+        Value base = parsePrimary();
+        if (!message.empty() || !accept("^")) {
+            return base;
+        }
+        Value exponent = parseUnary();
+        if (exponent.kind == CONSTANT && base.kind != CONSTANT) {
+            double n = exponent.constant;
+            if (n == std::floor(n) && std::fabs(n) <= MAX_INTEGER_POWER) {
+                return integerPower(base, static_cast<long>(n));
+            }
+            if (n == 0.5) {
+                return emit(OP_SQRT, base, base);
+            }
+        }
+        return emit(OP_POW, base, exponent);
+    }
+
+    Value parsePrimary() {
+        skipSpaces();
+        if (!message.empty() || position >= source.size()) {
+            fail("expected a value");
+            return constantValue(0.0);
+        }
+        char c = source[position];
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            const char* start = source.c_str() + position;
+            char* end;
+            double constant = std::strtod(start, &end);
+            position += end - start;
+            return constantValue(constant);
+        }
+        if (accept("(")) {
+            Value inner = parseComparison();
+            if (!accept(")")) {
+                fail("expected ')'");
+            }
+            return inner;
+        }
+        if (!std::isalpha(static_cast<unsigned char>(c))) {
+            fail("unexpected '" + std::string(1, c) + "'");
+            return constantValue(0.0);
+        }
+
+        size_t start = position;
+        while (position < source.size() && std::isalnum(static_cast<unsigned char>(source[position]))) {
+            ++position;
+        }
+        std::string name = source.substr(start, position - start);
+        if (name.size() > 1 && name[0] == 'x' && name.find_first_not_of("0123456789", 1) == std::string::npos) {
+            int d = std::atoi(name.c_str() + 1);
+            if (d >= MAX_EXPRESSION_VARIABLES) {
+                fail("coordinate " + name + " beyond x" + std::to_string(MAX_EXPRESSION_VARIABLES - 1));
+            }
+            numVariables = std::max(numVariables, d + 1);
+            return Value{INPUT, 0.0, d};
+        }
+        if (name == "pi") {
+            return constantValue(M_PI);
+        }
+        if (name == "e") {
+            return constantValue(M_E);
+        }
+
+        static const struct {
+            const char* name;
+            uint8_t opcode;
+            int arguments;
+        } functions[] = {
+            {"exp", OP_EXP, 1}, {"log", OP_LOG, 1}, {"sqrt", OP_SQRT, 1}, {"sin", OP_SIN, 1}, {"cos", OP_COS, 1},
+            {"tan", OP_TAN, 1}, {"abs", OP_ABS, 1}, {"pow", OP_POW, 2}, {"min", OP_MIN, 2}, {"max", OP_MAX, 2}
+        };
+        for (const auto& function : functions) {
+            if (name != function.name) {
+                continue;
+            }
+            if (!accept("(")) {
+                fail("expected '(' after " + name);
+                return constantValue(0.0);
+            }
+            Value left = parseComparison();
+            Value right = left;
+            if (function.arguments == 2 && message.empty()) {
+                if (!accept(",")) {
+                    fail(name + " takes two arguments");
+                }
+                right = parseComparison();
+            }
+            if (!accept(")")) {
+                fail("expected ')'");
+            }
+            return emit(function.opcode, left, right);
+        }
+        fail("unknown name '" + name + "'");
+        return constantValue(0.0);
+    }
+};
@@ -0,0 +1,295 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Registry of D-dimensional integrands over hyper-rectangles, selected with -F <name> and -D <dimension>.
+An integrand is evaluated a batch of points at a time: x[d][i] is coordinate d of point i (structure of arrays),
+so the per-point loops vectorise. New integrands are compile-time plugins: a struct with the static members below,
+registered with ECE_REGISTER_INTEGRAND(Type), in a header passed as -DLAB6_INTEGRAND_PLUGIN='"my_integrands.h"'.
+
+    struct MyIntegrand {
+        static const char* name();                      // -F name
+        static const char* description();
+        static int defaultDimension();
+        static bool supports(int dimension);
+        static void domain(int dimension, double* lower, double* upper);
+        static void evaluate(const double* const* x, int dimension, int count, double* out);
+        static double exact(int dimension);             // NaN if unknown
+    };
+
+The built-in set is the two Lab6 functions plus the Genz test family and the unit ball.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "ECE_VectorMath.h"
+
+constexpr int MAX_DIMENSION = 64;
+constexpr double GENZ_CENTRE = 0.5;   // Peak position w in every coordinate
+constexpr double GENZ_WIDTH = 5.0;    // Sharpness a in every coordinate
+
+// Function pointers of one registered integrand
+struct IntegrandInfo {
+    std::string name;
+    std::string description;
+    int defaultDimension;
+    bool (*supports)(int dimension);
+    void (*domain)(int dimension, double* lower, double* upper);
+    void (*evaluate)(const double* const* x, int dimension, int count, double* out);
+    double (*exact)(int dimension);
+};
+
+inline std::vector<IntegrandInfo>& integrandRegistry() {
+    static std::vector<IntegrandInfo> registry;
+    return registry;
+}
+
+// Registered integrand called name, or nullptr
+inline const IntegrandInfo* findIntegrand(const std::string& name) {
+    for (const IntegrandInfo& info : integrandRegistry()) {
+        if (info.name == name) {
+            return &info;
+        }
+    }
+    return nullptr;
+}
+
+// Static registrar: constructing one adds Type to the registry (once, however many times the header is included)
+template <typename Type>
+struct IntegrandRegistrar {
+    IntegrandRegistrar() {
+        if (findIntegrand(Type::name()) == nullptr) {
+            integrandRegistry().push_back(IntegrandInfo{Type::name(), Type::description(), Type::defaultDimension(),
+                                                        &Type::supports, &Type::domain, &Type::evaluate, &Type::exact});
+        }
+    }
+};
+
+#define ECE_REGISTER_INTEGRAND(Type) static IntegrandRegistrar<Type> eceIntegrandRegistrar##Type;
+
+// Fill lower/upper with the same interval in every dimension
+inline void cubeDomain(int dimension, double low, double high, double* lower, double* upper) {
+    for (int d = 0; d < dimension; ++d) {
+        lower[d] = low;
+        upper[d] = high;
+    }
+}
+
+// x^2 over [0, 1] (-P 1)
+struct SquareIntegrand {
+    static const char* name() { return "square"; }
+    static const char* description() { return "x^2 over [0, 1]"; }
+    static int defaultDimension() { return 1; }
+    static bool supports(int dimension) { return dimension == 1; }
+    static void domain(int dimension, double* lower, double* upper) { cubeDomain(dimension, 0.0, 1.0, lower, upper); }
+    static void evaluate(const double* const* x, int, int count, double* out) {
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) {
+            out[i] = x[0][i] * x[0][i];
+        }
+    }
+    static double exact(int) { return 1.0 / 3.0; }
+};
+
+// exp(-x^2) over [0, 1] (-P 2)
+struct GaussianTailIntegrand {
+    static const char* name() { return "expsquare"; }
+    static const char* description() { return "exp(-x^2) over [0, 1]"; }
+    static int defaultDimension() { return 1; }
+    static bool supports(int dimension) { return dimension == 1; }
+    static void domain(int dimension, double* lower, double* upper) { cubeDomain(dimension, 0.0, 1.0, lower, upper); }
+    static void evaluate(const double* const* x, int, int count, double* out) {
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) {
+            out[i] = simdExp(-x[0][i] * x[0][i]);
+        }
+    }
+    static double exact(int) { return 0.5 * std::sqrt(M_PI) * std::erf(1.0); }
+};
+
+// exp(-|x|^2) over [-1, 1]^D
+struct GaussianIntegrand {
+    static const char* name() { return "gaussian"; }
+    static const char* description() { return "exp(-|x|^2) over [-1, 1]^D"; }
+    static int defaultDimension() { return 6; }
+    static bool supports(int dimension) { return dimension >= 1 && dimension <= MAX_DIMENSION; }
+    static void domain(int dimension, double* lower, double* upper) { cubeDomain(dimension, -1.0, 1.0, lower, upper); }
+    static void evaluate(const double* const* x, int dimension, int count, double* out) {
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) {
+            out[i] = 0.0;
+        }
+        for (int d = 0; d < dimension; ++d) {
+            #pragma omp simd
+            for (int i = 0; i < count; ++i) {
+                out[i] -= x[d][i] * x[d][i];
+            }
+        }
+        simdExp(out, out, count);
+    }
+    static double exact(int dimension) { return std::pow(std::sqrt(M_PI) * std::erf(1.0), dimension); }
+};
+
+// Genz product peak: prod 1 / (a^-2 + (x_d - w)^2) over [0, 1]^D
+struct ProductPeakIntegrand {
+    static const char* name() { return "productpeak"; }
+    static const char* description() { return "Genz product peak, a = 5, w = 0.5, over [0, 1]^D"; }
+    static int defaultDimension() { return 6; }
+    static bool supports(int dimension) { return dimension >= 1 && dimension <= MAX_DIMENSION; }
+    static void domain(int dimension, double* lower, double* upper) { cubeDomain(dimension, 0.0, 1.0, lower, upper); }
+    static void evaluate(const double* const* x, int dimension, int count, double* out) {
+        const double inverseSquare = 1.0 / (GENZ_WIDTH * GENZ_WIDTH);
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) {
+            out[i] = 1.0;
+        }
+        for (int d = 0; d < dimension; ++d) {
+            #pragma omp simd
+            for (int i = 0; i < count; ++i) {
+                double offset = x[d][i] - GENZ_CENTRE;
+                out[i] /= inverseSquare + offset * offset;
+            }
+        }
+    }
+    static double exact(int dimension) {
+        double factor = GENZ_WIDTH * (std::atan(GENZ_WIDTH * (1.0 - GENZ_CENTRE)) + std::atan(GENZ_WIDTH * GENZ_CENTRE));
+        return std::pow(factor, dimension);
+    }
+};
+
+// Genz Gaussian: exp(-sum a^2 (x_d - w)^2) over [0, 1]^D
+struct GenzGaussianIntegrand {
+    static const char* name() { return "genzgaussian"; }
+    static const char* description() { return "Genz Gaussian, a = 5, w = 0.5, over [0, 1]^D"; }
+    static int defaultDimension() { return 6; }
+    static bool supports(int dimension) { return dimension >= 1 && dimension <= MAX_DIMENSION; }
+    static void domain(int dimension, double* lower, double* upper) { cubeDomain(dimension, 0.0, 1.0, lower, upper); }
+    static void evaluate(const double* const* x, int dimension, int count, double* out) {
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) {
+            out[i] = 0.0;
+        }
+        for (int d = 0; d < dimension; ++d) {
+            #pragma omp simd
+            for (int i = 0; i < count; ++i) {
+                double offset = GENZ_WIDTH * (x[d][i] - GENZ_CENTRE);
+                out[i] -= offset * offset;
+            }
+        }
+        simdExp(out, out, count);
+    }
+    static double exact(int dimension) {
+        double factor = std::sqrt(M_PI) / (2.0 * GENZ_WIDTH) * (std::erf(GENZ_WIDTH * (1.0 - GENZ_CENTRE)) + std::erf(GENZ_WIDTH * GENZ_CENTRE));
+        return std::pow(factor, dimension);
+    }
+};
+
+// Genz continuous: exp(-sum a |x_d - w|) over [0, 1]^D
+struct ContinuousIntegrand {
+    static const char* name() { return "continuous"; }
+    static const char* description() { return "Genz continuous, a = 5, w = 0.5, over [0, 1]^D"; }
+    static int defaultDimension() { return 6; }
+    static bool supports(int dimension) { return dimension >= 1 && dimension <= MAX_DIMENSION; }
+    static void domain(int dimension, double* lower, double* upper) { cubeDomain(dimension, 0.0, 1.0, lower, upper); }
+    static void evaluate(const double* const* x, int dimension, int count, double* out) {
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) {
+            out[i] = 0.0;
+        }
+        for (int d = 0; d < dimension; ++d) {
+            #pragma omp simd
+            for (int i = 0; i < count; ++i) {
+                out[i] -= GENZ_WIDTH * std::fabs(x[d][i] - GENZ_CENTRE);
+            }
+        }
+        simdExp(out, out, count);
+    }
+    static double exact(int dimension) {
+        double factor = (2.0 - std::exp(-GENZ_WIDTH * GENZ_CENTRE) - std::exp(-GENZ_WIDTH * (1.0 - GENZ_CENTRE))) / GENZ_WIDTH;
+        return std::pow(factor, dimension);
+    }
+};
+
+// Genz corner peak: (1 + sum x_d / D)^-(D + 1) over [0, 1]^D
+struct CornerPeakIntegrand {
+    static const char* name() { return "cornerpeak"; }
+    static const char* description() { return "Genz corner peak, a = 1/D, over [0, 1]^D"; }
+    static int defaultDimension() { return 6; }
+    static bool supports(int dimension) { return dimension >= 1 && dimension <= MAX_DIMENSION; }
+    static void domain(int dimension, double* lower, double* upper) { cubeDomain(dimension, 0.0, 1.0, lower, upper); }
+    static void evaluate(const double* const* x, int dimension, int count, double* out) {
+        const double a = 1.0 / dimension;
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) {
+            out[i] = 1.0;
+        }
+        for (int d = 0; d < dimension; ++d) {
+            #pragma omp simd
+            for (int i = 0; i < count; ++i) {
+                out[i] += a * x[d][i];
+            }
+        }
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) {
+            double base = 1.0 / out[i], power = base;
+            for (int d = 0; d < dimension; ++d) {
+                power *= base;
+            }
+            out[i] = power;
+        }
+    }
+    // Inclusion-exclusion over the 2^D corners: (1 / (D! a^D)) sum_S (-1)^|S| / (1 + a |S|); the alternating sum
+    // loses all precision beyond about 12 dimensions, so larger D have no reference value
+    static double exact(int dimension) {
+        if (dimension > 12) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        const double a = 1.0 / dimension;
+        double sum = 0.0, binomial = 1.0;
+        for (int k = 0; k <= dimension; ++k) {
+            sum += ((k % 2) ? -binomial : binomial) / (1.0 + a * k);
+            binomial = binomial * (dimension - k) / (k + 1);
+        }
+        return sum / (std::tgamma(dimension + 1.0) * std::pow(a, dimension));
+    }
+};
+
+// Indicator of the unit ball over [-1, 1]^D, whose integral is the ball's volume
+struct BallIntegrand {
+    static const char* name() { return "ball"; }
+    static const char* description() { return "indicator of |x| <= 1 over [-1, 1]^D (volume of the unit ball)"; }
+    static int defaultDimension() { return 6; }
+    static bool supports(int dimension) { return dimension >= 1 && dimension <= MAX_DIMENSION; }
+    static void domain(int dimension, double* lower, double* upper) { cubeDomain(dimension, -1.0, 1.0, lower, upper); }
+    static void evaluate(const double* const* x, int dimension, int count, double* out) {
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) {
+            out[i] = 0.0;
+        }
+        for (int d = 0; d < dimension; ++d) {
+            #pragma omp simd
+            for (int i = 0; i < count; ++i) {
+                out[i] += x[d][i] * x[d][i];
+            }
+        }
+        #pragma omp simd
+        for (int i = 0; i < count; ++i) {
+            out[i] = (out[i] <= 1.0) ? 1.0 : 0.0;
+        }
+    }
+    static double exact(int dimension) { return std::pow(M_PI, 0.5 * dimension) / std::tgamma(0.5 * dimension + 1.0); }
+};
+
+ECE_REGISTER_INTEGRAND(SquareIntegrand)
+ECE_REGISTER_INTEGRAND(GaussianTailIntegrand)
+ECE_REGISTER_INTEGRAND(GaussianIntegrand)
+ECE_REGISTER_INTEGRAND(ProductPeakIntegrand)
+ECE_REGISTER_INTEGRAND(GenzGaussianIntegrand)
+ECE_REGISTER_INTEGRAND(ContinuousIntegrand)
+ECE_REGISTER_INTEGRAND(CornerPeakIntegrand)
+ECE_REGISTER_INTEGRAND(BallIntegrand)
@@ -0,0 +1,86 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Sample streams for the Monte Carlo integrator. The N samples are cut into fixed chunks of
+CHUNK_SAMPLES and chunk c draws its uniforms from Philox stream (seed, c), generated a whole chunk at a time.
+Ranks take contiguous runs of chunks and share them out again between std::threads; chunk sums are added in
+fixed point (ExactSum), so a given seed gives the same bits whatever the number of ranks and threads.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+
+#include "ECE_Philox.h"
+
+constexpr int CHUNK_SAMPLES = 4096;           // Samples per chunk (even: two uniforms per Philox block)
+constexpr double FRACTION_SCALE = 1099511627776.0;   // 2^40, the fixed-point resolution of ExactSum
+
+// Contiguous run [first, last) of chunks handed to one worker
+struct ChunkRange {
+    long long first;
+    long long last;
+};
+
+// Share numChunks chunks as evenly as possible between numWorkers workers
+inline ChunkRange splitChunks(long long numChunks, int worker, int numWorkers) {
+    return ChunkRange{numChunks * worker / numWorkers, numChunks * (worker + 1) / numWorkers};
+}
+
+// Samples in chunk `chunk` when numSamples are drawn in total
+inline int chunkSamples(long long chunk, long long numSamples) {
+    long long remaining = numSamples - chunk * CHUNK_SAMPLES;
+    return static_cast<int>(remaining < CHUNK_SAMPLES ? remaining : CHUNK_SAMPLES);
+}
+
+// Uniforms in [0, 1) of coordinate `dimension` for the first count samples of chunk `chunk`, 53 bits each from two
+// Philox words (the coordinate is the high word of the block counter). u must hold count rounded up to even.
+inline void fillUniforms(uint64_t seed, uint64_t chunk, uint32_t dimension, int count, double* u) {
+    int blocks = (count + 1) / 2;
+    uint32_t k0 = static_cast<uint32_t>(seed), k1 = static_cast<uint32_t>(seed >> 32);
+    uint32_t c0 = static_cast<uint32_t>(chunk), c1 = static_cast<uint32_t>(chunk >> 32);
+    #pragma omp simd
+    for (int b = 0; b < blocks; ++b) {
+        PhiloxBlock bits = philox4x32(c0, c1, static_cast<uint32_t>(b), dimension, k0, k1);
+        u[2 * b] = ((bits.v[0] >> 5) * 67108864.0 + (bits.v[1] >> 6)) * (1.0 / 9007199254740992.0);
+        u[2 * b + 1] = ((bits.v[2] >> 5) * 67108864.0 + (bits.v[3] >> 6)) * (1.0 / 9007199254740992.0);
+    }
+}
+
+// Fixed-point sum of chunk sums. Integer addition is associative, so the total does not depend on how
+// chunks are grouped between ranks; each chunk sum is rounded to 2^-40 once, when it is added.
+struct ExactSum {
+    long long whole = 0;      // Integer part
+    long long fraction = 0;   // Fractional part in units of 2^-40
+
+    void add(double value) {
+        double integer = std::floor(value);
+        whole += static_cast<long long>(integer);
+        fraction += std::llround((value - integer) * FRACTION_SCALE);
+        normalise();
+    }
+
+    // Carry whole units out of the fraction (needed after adding several partial fractions together)
+    void normalise() {
+        long long carry = fraction >> 40;
+        whole += carry;
+        fraction -= carry << 40;
+    }
+
+    double value() const {
+        return static_cast<double>(whole) + fraction / FRACTION_SCALE;
+    }
+};
+
+// Pseudo-random sample points: uniforms of every coordinate from the Philox stream of each chunk
+struct PhiloxFill {
+    uint64_t seed;
+    int dimension;
+    void operator()(long long chunk, int count, double* const* u) const {
+        for (int d = 0; d < dimension; ++d) {
+            fillUniforms(seed, chunk, d, count, u[d]);
+        }
+    }
+};
@@ -0,0 +1,82 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: The MPI calls used by the Lab6 integrator. Normally this is just <mpi.h>; built with -DLAB6_NO_MPI
+it is a single-rank stand-in (one process, rank 0 of 1, collectives copy their input), so the same program
+and command line run on machines without an MPI installation, with threads as the only parallelism.
+*/
+
+#pragma once
+
+#ifndef LAB6_NO_MPI
+
+#include <mpi.h>
+
+#else
+
+#include <cstring>
+
+// A datatype is its size in bytes, which is all a single rank needs to copy buffers
+typedef int MPI_Datatype;
+typedef int MPI_Comm;
+typedef int MPI_Op;
+typedef int MPI_Request;
+struct MPI_Status {
+    int MPI_SOURCE;
+    int MPI_TAG;
+    int MPI_ERROR;
+};
+
+#define MPI_SUCCESS 0
+#define MPI_COMM_WORLD 0
+#define MPI_SUM 0
+#define MPI_MAX 1
+#define MPI_MIN 2
+#define MPI_CHAR static_cast<MPI_Datatype>(sizeof(char))
+#define MPI_INT static_cast<MPI_Datatype>(sizeof(int))
+#define MPI_LONG_LONG static_cast<MPI_Datatype>(sizeof(long long))
+#define MPI_UNSIGNED_LONG_LONG static_cast<MPI_Datatype>(sizeof(unsigned long long))
+#define MPI_DOUBLE static_cast<MPI_Datatype>(sizeof(double))
+#define MPI_IN_PLACE reinterpret_cast<void*>(1)
+#define MPI_REQUEST_NULL 0
+#define MPI_STATUS_IGNORE static_cast<MPI_Status*>(nullptr)
+#define MPI_THREAD_FUNNELED 1
+
+inline int MPI_Init(int*, char***) { return MPI_SUCCESS; }
+inline int MPI_Init_thread(int*, char***, int required, int* provided) { *provided = required; return MPI_SUCCESS; }
+inline int MPI_Finalize() { return MPI_SUCCESS; }
+inline int MPI_Comm_size(MPI_Comm, int* size) { *size = 1; return MPI_SUCCESS; }
+inline int MPI_Comm_rank(MPI_Comm, int* rank) { *rank = 0; return MPI_SUCCESS; }
+inline int MPI_Bcast(void*, int, MPI_Datatype, int, MPI_Comm) { return MPI_SUCCESS; }
+inline int MPI_Barrier(MPI_Comm) { return MPI_SUCCESS; }
+
+// With one rank every reduction is a copy of the send buffer
+inline int MPI_Reduce(const void* send, void* receive, int count, MPI_Datatype type, MPI_Op, int, MPI_Comm) {
+    if (send != MPI_IN_PLACE) {
+        std::memcpy(receive, send, static_cast<size_t>(count) * type);
+    }
+    return MPI_SUCCESS;
+}
+
+inline int MPI_Allreduce(const void* send, void* receive, int count, MPI_Datatype type, MPI_Op op, MPI_Comm comm) {
+    return MPI_Reduce(send, receive, count, type, op, 0, comm);
+}
+
+inline int MPI_Iallreduce(const void* send, void* receive, int count, MPI_Datatype type, MPI_Op op, MPI_Comm comm, MPI_Request* request) {
+    *request = MPI_REQUEST_NULL;
+    return MPI_Reduce(send, receive, count, type, op, 0, comm);
+}
+
+inline int MPI_Wait(MPI_Request* request, MPI_Status*) {
+    *request = MPI_REQUEST_NULL;
+    return MPI_SUCCESS;
+}
+
+inline int MPI_Test(MPI_Request* request, int* flag, MPI_Status*) {
+    *request = MPI_REQUEST_NULL;
+    *flag = 1;
+    return MPI_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,52 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Philox4x32-10 counter-based random number generator (Salmon et al., "Parallel random numbers:
+as easy as 1, 2, 3", SC'11). Each call maps a 128-bit counter and a 64-bit key to 128 random bits with no
+state, so a stream can be addressed directly by (seed, chunk, block) and the results do not depend on how
+the samples are split between ranks and threads.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+constexpr uint32_t PHILOX_M0 = 0xD2511F53u;   // Round multipliers
+constexpr uint32_t PHILOX_M1 = 0xCD9E8D57u;
+constexpr uint32_t PHILOX_W0 = 0x9E3779B9u;   // Key schedule (Weyl) increments
+constexpr uint32_t PHILOX_W1 = 0xBB67AE85u;
+
+// 128 random bits as four 32-bit words
+struct PhiloxBlock {
+    uint32_t v[4];
+};
+
+// One Philox round on the counter with the given round key
+inline void philoxRound(uint32_t& c0, uint32_t& c1, uint32_t& c2, uint32_t& c3, uint32_t k0, uint32_t k1) {
+    uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * c0;
+    uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * c2;
+    uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+    uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+    c1 = static_cast<uint32_t>(p1);
+    c3 = static_cast<uint32_t>(p0);
+    c0 = n0;
+    c2 = n2;
+}
+
+// Philox4x32-10 of counter (c0, c1, c2, c3) under key (k0, k1)
+inline PhiloxBlock philox4x32(uint32_t c0, uint32_t c1, uint32_t c2, uint32_t c3, uint32_t k0, uint32_t k1) {
+    for (int round = 0; round < 10; ++round) {
+        philoxRound(c0, c1, c2, c3, k0, k1);
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    return PhiloxBlock{{c0, c1, c2, c3}};
+}
+
+// Block `block` of the stream owned by (seed, stream): counter = (stream, block), key = seed
+inline PhiloxBlock philoxStream(uint64_t seed, uint64_t stream, uint64_t block) {
+    return philox4x32(static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32),
+                      static_cast<uint32_t>(block), static_cast<uint32_t>(block >> 32),
+                      static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32));
+}
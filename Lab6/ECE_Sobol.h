@@ -0,0 +1,134 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Owen-scrambled Sobol points for quasi-Monte Carlo integration. Directions use the Joe-Kuo
+new-joe-kuo-6.21201 primitive polynomials for the first 21 dimensions; the nested uniform (Owen) scramble is
+the hash-based Laine-Karras permutation (Burley, "Practical Hash-based Owen Scrambling", JCGT 2020). Point i is
+computed directly from the bits of i, so chunk c of a replica is the disjoint index segment
+[c * CHUNK_SAMPLES, (c + 1) * CHUNK_SAMPLES) and ranks and threads skip ahead to their chunks for free.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ECE_Philox.h"
+#include "ECE_MonteCarlo.h"
+
+constexpr int SOBOL_BITS = 32;
+constexpr int MAX_SOBOL_DIMENSION = 21;
+constexpr uint64_t SOBOL_STREAM_TAG = 0x534F424Cull << 32;   // "SOBL": keeps scramble seeds off the chunk streams
+
+// Primitive polynomial of one dimension: degree s, interior coefficients a and initial direction numbers m
+struct SobolPolynomial {
+    int s;
+    uint32_t a;
+    uint32_t m[7];
+};
+
+// Dimensions 2 to 21 (dimension 1 is the van der Corput sequence)
+const SobolPolynomial SOBOL_POLYNOMIALS[MAX_SOBOL_DIMENSION - 1] = {
+    {1, 0, {1}},
+    {2, 1, {1, 3}},
+    {3, 1, {1, 3, 1}},
+    {3, 2, {1, 1, 1}},
+    {4, 1, {1, 1, 3, 3}},
+    {4, 4, {1, 3, 5, 13}},
+    {5, 2, {1, 1, 5, 5, 17}},
+    {5, 4, {1, 1, 5, 5, 5}},
+    {5, 7, {1, 1, 7, 11, 19}},
+    {5, 11, {1, 1, 5, 1, 1}},
+    {5, 13, {1, 1, 1, 3, 11}},
+    {5, 14, {1, 3, 5, 5, 31}},
+    {6, 1, {1, 3, 3, 9, 7, 49}},
+    {6, 13, {1, 1, 1, 15, 21, 21}},
+    {6, 16, {1, 3, 1, 13, 27, 49}},
+    {6, 19, {1, 1, 1, 15, 7, 5}},
+    {6, 22, {1, 3, 1, 15, 13, 25}},
+    {6, 25, {1, 1, 5, 5, 19, 61}},
+    {7, 1, {1, 3, 7, 11, 23, 15, 103}},
+    {7, 4, {1, 3, 7, 13, 13, 15, 69}}
+};
+
+// Direction numbers v[k] (bit k of the index contributes v[k]) of dimension 0 <= dimension < MAX_SOBOL_DIMENSION
+inline void sobolDirections(int dimension, uint32_t v[SOBOL_BITS]) {
+    if (dimension == 0) {
+        for (int k = 0; k < SOBOL_BITS; ++k) {
+            v[k] = 1u << (SOBOL_BITS - 1 - k);
+        }
+        return;
+    }
+    const SobolPolynomial& p = SOBOL_POLYNOMIALS[dimension - 1];
+    for (int k = 0; k < p.s; ++k) {
+        v[k] = p.m[k] << (SOBOL_BITS - 1 - k);
+    }
+    for (int k = p.s; k < SOBOL_BITS; ++k) {
+        v[k] = v[k - p.s] ^ (v[k - p.s] >> p.s);
+        for (int j = 1; j < p.s; ++j) {
+            v[k] ^= ((p.a >> (p.s - 1 - j)) & 1u) * v[k - j];
+        }
+    }
+}
+
+// The 32 bits of x in reverse order
+inline uint32_t reverseBits(uint32_t x) {
+    x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+    x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+    x = ((x >> 4) & 0x0F0F0F0Fu) | ((x & 0x0F0F0F0Fu) << 4);
+    x = ((x >> 8) & 0x00FF00FFu) | ((x & 0x00FF00FFu) << 8);
+    return (x >> 16) | (x << 16);
+}
+
+// Nested uniform scramble of a 32-bit fraction: the Laine-Karras hash applied to the bit-reversed value, so
+// every bit is flipped depending only on the bits above it
+inline uint32_t owenScramble(uint32_t x, uint32_t seed) {
+    x = reverseBits(x);
+    x += seed;
+    x ^= x * 0x6C50B47Cu;
+    x ^= x * 0xB82F1E52u;
+    x ^= x * 0xC7AFE638u;
+    x ^= x * 0x8D22F6E6u;
+    return reverseBits(x);
+}
+
+// Scramble seed of (replica, dimension), drawn from its own Philox stream
+inline uint32_t sobolScrambleSeed(uint64_t seed, int replica, int dimension) {
+    return philoxStream(seed, SOBOL_STREAM_TAG | static_cast<uint32_t>(replica), static_cast<uint64_t>(dimension)).v[0];
+}
+
+// Scrambled coordinates in (0, 1) of points [chunk * CHUNK_SAMPLES, chunk * CHUNK_SAMPLES + count) in the
+// dimension with directions v; indices must stay below 2^32
+inline void fillSobol(const uint32_t v[SOBOL_BITS], uint32_t scrambleSeed, uint64_t chunk, int count, double* u) {
+    uint32_t first = static_cast<uint32_t>(chunk * CHUNK_SAMPLES);
+    #pragma omp simd
+    for (int i = 0; i < count; ++i) {
+        uint32_t index = first + static_cast<uint32_t>(i);
+        uint32_t x = 0;
+        for (int k = 0; k < SOBOL_BITS; ++k) {
+            x ^= v[k] & (0u - ((index >> k) & 1u));
+        }
+        u[i] = (owenScramble(x, scrambleSeed) + 0.5) * (1.0 / 4294967296.0);
+    }
+}
+
+// Quasi-random sample points: one scrambled replica of the first `dimension` Sobol coordinates, for sumMoments
+struct SobolFill {
+    int dimension;
+    std::vector<uint32_t> directions;      // SOBOL_BITS per coordinate
+    std::vector<uint32_t> scrambleSeeds;
+
+    SobolFill(uint64_t seed, int replica, int dimension) : dimension(dimension), directions(dimension * SOBOL_BITS), scrambleSeeds(dimension) {
+        for (int d = 0; d < dimension; ++d) {
+            sobolDirections(d, &directions[d * SOBOL_BITS]);
+            scrambleSeeds[d] = sobolScrambleSeed(seed, replica, d);
+        }
+    }
+
+    void operator()(long long chunk, int count, double* const* u) const {
+        for (int d = 0; d < dimension; ++d) {
+            fillSobol(&directions[d * SOBOL_BITS], scrambleSeeds[d], chunk, count, u[d]);
+        }
+    }
+};
@@ -0,0 +1,284 @@
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: Variance reduction for the Monte Carlo integrator over a hyper-rectangle, mapped from the unit cube
+of the uniforms, as options that compose freely:
+  - stratification: uniform j of a chunk lands in stratum j mod K of K equal strata of the first coordinate
+    (Philox uniforms only; Sobol points are already stratified and must use K = 1),
+  - antithetic variates: every uniform point u is also used as 1 - u,
+  - importance sampling: each coordinate is drawn from the tilted density g(u) = l e^(l u) / (e^l - 1), weighted by 1 / g,
+  - a control variate h(u) = u_0 (integral 1/2) whose coefficient is fitted from the same samples.
+One observation is the mean over the K strata (and the antithetic pair) of f / g, so observations are independent
+and their plain sample variance gives the standard error. Chunks are evaluated in SIMD-friendly passes and their
+moments (sum, sum of squares, and the control cross terms) are added in fixed point, ready for MPI_Reduce.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+#include "ECE_MonteCarlo.h"
+#include "ECE_Integrands.h"
+
+constexpr double CONTROL_MEAN = 0.5;   // Integral of the control h(u) = u_0 over the unit cube
+constexpr int MOMENT_WORDS = 11;       // Five ExactSums and the observation count, as long longs
+constexpr int EVALUATION_BATCH = 256;  // Points per integrand call (a multiple of the SIMD width)
+
+// Which variance reduction techniques are applied
+struct SamplingOptions {
+    int strata = 1;            // K, a power of two dividing CHUNK_SAMPLES
+    bool antithetic = false;
+    bool control = false;
+    double tilt = 0.0;         // Importance sampling exponent l; 0 samples uniformly
+
+    int evaluationsPerUniform() const { return antithetic ? 2 : 1; }
+};
+
+// Point and importance weight 1 / g(x) for a uniform u under tilt l
+inline double tiltedPoint(double u, double tilt, double& weight) {
+    if (tilt == 0.0) {
+        weight = 1.0;
+        return u;
+    }
+    double scale = std::expm1(tilt);
+    double x = std::log1p(u * scale) / tilt;
+    weight = scale / (tilt * std::exp(tilt * x));
+    return x;
+}
+
+// Hyper-rectangle sampled: the unit cube of the uniforms is mapped onto it, and values are scaled by its volume
+struct Domain {
+    int dimension = 1;
+    double lower[MAX_DIMENSION];
+    double width[MAX_DIMENSION];
+    double volume = 1.0;
+
+    Domain(int dimension, const double* low, const double* high) : dimension(dimension) {
+        for (int d = 0; d < dimension; ++d) {
+            lower[d] = low[d];
+            width[d] = high[d] - low[d];
+            volume *= width[d];
+        }
+    }
+};
+
+// Map uniforms u[d][first, first + count) of a chunk to points x[d][0, count) of the domain and their importance
+// weights 1 / g, or their antithetic partners 1 - u. Uniform j of a chunk lies in stratum j mod K of the first
+// coordinate; importance tilting applies to every coordinate and the weights multiply.
+inline void mapUniforms(const SamplingOptions& options, const Domain& domain, const double* const* u, int first, int count,
+                        bool mirrored, double* const* x, double* weight) {
+    double inverseStrata = 1.0 / options.strata;
+    int strataMask = options.strata - 1;
+    #pragma omp simd
+    for (int j = 0; j < count; ++j) {
+        weight[j] = domain.volume;
+    }
+    for (int d = 0; d < domain.dimension; ++d) {
+        const double* ud = u[d] + first;
+        double* xd = x[d];
+        double lower = domain.lower[d], width = domain.width[d];
+        #pragma omp simd
+        for (int j = 0; j < count; ++j) {
+            double v = mirrored ? 1.0 - ud[j] : ud[j];
+            if (d == 0) {
+                v = (static_cast<double>((first + j) & strataMask) + v) * inverseStrata;
+            }
+            double w;
+            xd[j] = lower + width * tiltedPoint(v, options.tilt, w);
+            weight[j] *= w;
+        }
+    }
+}
+
+// Per-uniform value f / g (averaged over the antithetic pair) and control h / g, h the first unit-cube coordinate,
+// for uniforms [first, first + count) of a chunk; f(x, count, out) evaluates a batch of points
+template <typename Batch>
+inline void evaluateUniforms(const Batch& f, const SamplingOptions& options, const Domain& domain, const double* const* u,
+                             int first, int count, double* const* x, double* weight, double* scratch, double* value, double* control) {
+    double lower = domain.lower[0], inverseWidth = 1.0 / domain.width[0];
+    for (int pass = 0; pass < options.evaluationsPerUniform(); ++pass) {
+        mapUniforms(options, domain, u, first, count, pass == 1, x, weight);
+        f(x, count, scratch);
+        double share = 1.0 / options.evaluationsPerUniform();
+        #pragma omp simd
+        for (int j = 0; j < count; ++j) {
+            double y = share * scratch[j] * weight[j];
+            double h = share * (x[0][j] - lower) * inverseWidth * weight[j] / domain.volume;
+            value[j] = (pass == 0) ? y : value[j] + y;
+            control[j] = (pass == 0) ? h : control[j] + h;
+        }
+    }
+}
+
+// Fixed-point moments of the observations y and, for the control variate, z
+struct MomentSums {
+    ExactSum y, yy, z, zz, yz;
+    long long count = 0;
+
+    void merge(const MomentSums& other) {
+        ExactSum* mine[] = {&y, &yy, &z, &zz, &yz};
+        const ExactSum* theirs[] = {&other.y, &other.yy, &other.z, &other.zz, &other.yz};
+        for (int m = 0; m < 5; ++m) {
+            mine[m]->whole += theirs[m]->whole;
+            mine[m]->fraction += theirs[m]->fraction;
+            mine[m]->normalise();
+        }
+        count += other.count;
+    }
+
+    // Flatten to MOMENT_WORDS long longs for MPI_LONG_LONG reductions, and back
+    void pack(long long* words) const {
+        const ExactSum* sums[] = {&y, &yy, &z, &zz, &yz};
+        for (int m = 0; m < 5; ++m) {
+            words[2 * m] = sums[m]->whole;
+            words[2 * m + 1] = sums[m]->fraction;
+        }
+        words[10] = count;
+    }
+
+    void unpack(const long long* words) {
+        ExactSum* sums[] = {&y, &yy, &z, &zz, &yz};
+        for (int m = 0; m < 5; ++m) {
+            sums[m]->whole = words[2 * m];
+            sums[m]->fraction = words[2 * m + 1];
+            sums[m]->normalise();
+        }
+        count = words[10];
+    }
+};
+
+// Estimate and standard error from the combined moments, with the control variate if it was sampled
+struct Estimate {
+    double value;
+    double standardError;
+    double controlCoefficient;
+};
+
+inline Estimate combineMoments(const MomentSums& sums, bool control) {
+    double n = static_cast<double>(sums.count);
+    double meanY = sums.y.value() / n;
+    double syy = sums.yy.value() - n * meanY * meanY;
+    Estimate estimate = {meanY, (n > 1.0) ? std::sqrt(std::max(0.0, syy) / (n - 1.0) / n) : 0.0, 0.0};
+    if (control && n > 2.0) {
+        double meanZ = sums.z.value() / n;
+        double szz = sums.zz.value() - n * meanZ * meanZ;
+        double syz = sums.yz.value() - n * meanY * meanZ;
+        if (szz > 1e-12 * sums.zz.value()) {
+            double c = syz / szz;
+            double residual = std::max(0.0, syy - c * syz);
+            estimate.value = meanY - c * (meanZ - CONTROL_MEAN);
+            estimate.standardError = std::sqrt(residual / (n - 2.0) / n);
+            estimate.controlCoefficient = c;
+        }
+    }
+    return estimate;
+}
+
+// Moments of the observations from the uniforms of chunks [range.first, range.last), split between numThreads
+// threads; fill(chunk, count, u) writes the uniforms u[d] of every coordinate of a chunk, f(x, count, out)
+// evaluates a batch of EVALUATION_BATCH points, and numUniforms is a multiple of the strata
+template <typename Batch, typename Fill>
+inline MomentSums sumMoments(const Batch& f, const Fill& fill, const SamplingOptions& options, const Domain& domain,
+                             long long numUniforms, ChunkRange range, int numThreads) {
+    std::vector<MomentSums> partials(numThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        ChunkRange share = splitChunks(range.last - range.first, t, numThreads);
+        threads.emplace_back([&, share, t]() {
+            int dimension = domain.dimension;
+            std::vector<double> uniforms(dimension * CHUNK_SAMPLES), points(dimension * EVALUATION_BATCH);
+            std::vector<double> weight(EVALUATION_BATCH), scratch(EVALUATION_BATCH), value(CHUNK_SAMPLES), control(CHUNK_SAMPLES);
+            std::vector<double*> u(dimension), x(dimension);
+            for (int d = 0; d < dimension; ++d) {
+                u[d] = &uniforms[d * CHUNK_SAMPLES];
+                x[d] = &points[d * EVALUATION_BATCH];
+            }
+            int strata = options.strata;
+            for (long long chunk = range.first + share.first; chunk < range.first + share.last; ++chunk) {
+                int count = chunkSamples(chunk, numUniforms);
+                fill(chunk, count, u.data());
+                for (int first = 0; first < count; first += EVALUATION_BATCH) {
+                    int batch = std::min(EVALUATION_BATCH, count - first);
+                    evaluateUniforms(f, options, domain, u.data(), first, batch, x.data(), weight.data(), scratch.data(),
+                                     value.data() + first, control.data() + first);
+                }
+
+                // Collapse each group of strata to one observation, then take the chunk's moments in order
+                int observations = count / strata;
+                double sy = 0.0, syy = 0.0, sz = 0.0, szz = 0.0, syz = 0.0;
+                #pragma omp simd reduction(+:sy, syy, sz, szz, syz)
+                for (int g = 0; g < observations; ++g) {
+                    double y = 0.0, z = 0.0;
+                    for (int k = 0; k < strata; ++k) {
+                        y += value[g * strata + k];
+                        z += control[g * strata + k];
+                    }
+                    y /= strata;
+                    z /= strata;
+                    sy += y;
+                    syy += y * y;
+                    sz += z;
+                    szz += z * z;
+                    syz += y * z;
+                }
+                partials[t].y.add(sy);
+                partials[t].yy.add(syy);
+                partials[t].z.add(sz);
+                partials[t].zz.add(szz);
+                partials[t].yz.add(syz);
+                partials[t].count += observations;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    MomentSums total;
+    for (const auto& partial : partials) {
+        total.merge(partial);
+    }
+    return total;
+}
+
+// Add the packed moment sets of `round` into `total`
+inline void accumulateSets(std::vector<long long>& total, const std::vector<long long>& round, int numSets) {
+    for (int r = 0; r < numSets; ++r) {
+        MomentSums sums, more;
+        sums.unpack(&total[r * MOMENT_WORDS]);
+        more.unpack(&round[r * MOMENT_WORDS]);
+        sums.merge(more);
+        sums.pack(&total[r * MOMENT_WORDS]);
+    }
+}
+
+// Estimate from numSets packed moment sets: one set is plain Monte Carlo; several are QMC replicas, whose
+// spread is the error (the variance within a replica is not)
+inline Estimate combineSets(const std::vector<long long>& moments, int numSets, bool control) {
+    std::vector<Estimate> estimates(numSets);
+    for (int r = 0; r < numSets; ++r) {
+        MomentSums sums;
+        sums.unpack(&moments[r * MOMENT_WORDS]);
+        estimates[r] = combineMoments(sums, control);
+    }
+    if (numSets == 1) {
+        return estimates[0];
+    }
+
+    Estimate combined = {0.0, 0.0, estimates[0].controlCoefficient};
+    for (const Estimate& estimate : estimates) {
+        combined.value += estimate.value;
+    }
+    combined.value /= numSets;
+    double variance = 0.0;
+    for (const Estimate& estimate : estimates) {
+        variance += (estimate.value - combined.value) * (estimate.value - combined.value);
+    }
+    combined.standardError = std::sqrt(variance / (numSets - 1) / numSets);
+    return combined;
+}
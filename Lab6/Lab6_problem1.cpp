@@ -1,7 +1,45 @@
-#include <mpi.h>
+/*
+Author: Arati Ganesh
+Class: ECE6122
+Last Date Modified: 18/10/2026
+Description: MPI Monte Carlo estimate of the integral over [0, 1] of x^2 (-P 1) or exp(-x^2) (-P 2) from N
+samples, with -T std::threads inside each rank (e.g. one rank per socket). Samples come from counter-based
+Philox streams (ECE_MonteCarlo.h), so a run is reproducible from its seed (-S) whatever the number of ranks
+and threads. -Q R switches to quasi-Monte Carlo: R independently Owen-scrambled Sobol replicas of N points each
+(ECE_Sobol.h), whose spread gives the standard error. Stratification (-K, plain Monte Carlo only: Sobol points are
+already stratified), antithetic variates (-A), a control variate (-C) and importance sampling (-I) combine freely
+(ECE_VarianceReduction.h); -N counts integrand evaluations.
+With an absolute (-E) or relative (-R) target error the ranks sample in rounds until the 95% confidence interval
+is that tight, overlapping each round's MPI_Iallreduce with the next round's sampling (ECE_AdaptiveSampling.h):
+sampling threads never call MPI, and the main thread tests the reduction until it completes.
+Instead of -P, -F <name> -D <dimension> integrates a registered D-dimensional integrand over its hyper-rectangle
+(ECE_Integrands.h, -F list to see them); more can be compiled in with -DLAB6_INTEGRAND_PLUGIN='"file.h"'.
+Or -f "<expression>" integrates an expression of x0, x1, ... over the unit cube without recompiling: rank 0
+compiles it to bytecode, broadcasts it, and every rank interprets it a batch at a time (ECE_Expression.h).
+
+Build: mpicxx -std=c++14 -O3 -march=native -fopenmp-simd -pthread Lab6_problem1.cpp -o integral_mpi
+Without MPI: g++ -std=c++14 -O3 -march=native -fopenmp-simd -pthread -DLAB6_NO_MPI Lab6_problem1.cpp -o integral
+*/
+
 #include <iostream>
+#include <string>
 #include <cstdlib>
 #include <cmath>
+#include <ctime>
+#include <thread>
+#include <algorithm>
+#include <vector>
+#include <chrono>
+
+#include "ECE_MpiStubs.h"
+#include "ECE_MonteCarlo.h"
+#include "ECE_Sobol.h"
+#include "ECE_VarianceReduction.h"
+#include "ECE_AdaptiveSampling.h"
+#include "ECE_Expression.h"
+#ifdef LAB6_INTEGRAND_PLUGIN
+#include LAB6_INTEGRAND_PLUGIN
+#endif
 
 
 double integralFunction1(double x) {
@@ -14,56 +52,286 @@ double integralFunction2(double x) {
 }
 
 int main(int argc, char *argv[]) {
-    MPI_Init(&argc, &argv);
+    // Only the main thread calls MPI; the sampling threads never do
+    int threadSupport;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &threadSupport);
 
     int world_size, world_rank;
     MPI_Comm_size(MPI_COMM_WORLD, &world_size);
     MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
 
+    // Overlapping a round's reduction with the next round's sampling needs a helper thread next to the MPI
+    // thread; without MPI_THREAD_FUNNELED the rounds are sampled and reduced one after the other
+    bool overlapRounds = threadSupport >= MPI_THREAD_FUNNELED;
+
     // Check for proper argument count
-    if (argc != 5) {
+    if (argc < 3 || argc % 2 == 0) {
         if (world_rank == 0) {
-            std::cerr << "Usage: " << argv[0] << " -P [1|2] -N <number_of_samples>\n";
+            std::cerr << "Usage: " << argv[0] << " -P [1|2] | -F <integrand|list> | -f <expression> [-D <dimension>] -N <number_of_samples> [-E <absolute_error>] [-R <relative_error>] [-Q <sobol_replicas>] [-K <strata>] [-A 0|1] [-C 0|1]"
+                      << " [-I <importance_tilt>] [-S <seed>] [-T <threads_per_rank>]\n";
         }
         MPI_Finalize();
         return 1;
     }
 
     // Parse command line arguments
-    int P = -1, N = -1;
+    int P = -1;
+    std::string integrandName, expressionText;
+    int dimension = 0;
+    long long N = -1;
+    int replicas = 0;
+    double absoluteTarget = 0.0, relativeTarget = 0.0;
+    SamplingOptions options;
+    int numThreads = std::max(1u, std::thread::hardware_concurrency());
+    unsigned long long seed = time(NULL);
     for (int i = 1; i < argc; i += 2) {
         if (std::string(argv[i]) == "-P") {
             P = std::atoi(argv[i + 1]);
+        } else if (std::string(argv[i]) == "-F") {
+            integrandName = argv[i + 1];
+        } else if (std::string(argv[i]) == "-f") {
+            expressionText = argv[i + 1];
+        } else if (std::string(argv[i]) == "-D") {
+            dimension = std::atoi(argv[i + 1]);
         } else if (std::string(argv[i]) == "-N") {
-            N = std::atoi(argv[i + 1]);
+            N = std::atoll(argv[i + 1]);
+        } else if (std::string(argv[i]) == "-E") {
+            absoluteTarget = std::atof(argv[i + 1]);
+        } else if (std::string(argv[i]) == "-R") {
+            relativeTarget = std::atof(argv[i + 1]);
+        } else if (std::string(argv[i]) == "-Q") {
+            replicas = std::atoi(argv[i + 1]);
+        } else if (std::string(argv[i]) == "-K") {
+            options.strata = std::atoi(argv[i + 1]);
+        } else if (std::string(argv[i]) == "-A") {
+            options.antithetic = std::atoi(argv[i + 1]) != 0;
+        } else if (std::string(argv[i]) == "-C") {
+            options.control = std::atoi(argv[i + 1]) != 0;
+        } else if (std::string(argv[i]) == "-I") {
+            options.tilt = std::atof(argv[i + 1]);
+        } else if (std::string(argv[i]) == "-S") {
+            seed = std::strtoull(argv[i + 1], nullptr, 10);
+        } else if (std::string(argv[i]) == "-T") {
+            numThreads = std::max(1, std::atoi(argv[i + 1]));
+        }
+    }
+
+    if (integrandName == "list") {
+        if (world_rank == 0) {
+            for (const IntegrandInfo& info : integrandRegistry()) {
+                std::cout << "    " << info.name << ": " << info.description << " (default D = " << info.defaultDimension << ")" << std::endl;
+            }
         }
+        MPI_Finalize();
+        return 0;
+    }
+
+    // An expression is compiled on rank 0 only and its bytecode broadcast (size -1 if it did not compile)
+    bool useExpression = !expressionText.empty();
+    ExpressionProgram program;
+    if (useExpression) {
+        std::vector<char> bytecode;
+        if (world_rank == 0) {
+            std::string error;
+            if (ExpressionCompiler().compile(expressionText, program, error)) {
+                bytecode = program.serialise();
+            } else {
+                std::cerr << "Invalid expression: " << error << "\n";
+            }
+        }
+        int size = (world_rank == 0 && bytecode.empty()) ? -1 : static_cast<int>(bytecode.size());
+        MPI_Bcast(&size, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        if (size < 0) {
+            MPI_Finalize();
+            return 1;
+        }
+        bytecode.resize(size);
+        MPI_Bcast(bytecode.data(), size, MPI_CHAR, 0, MPI_COMM_WORLD);
+        program.deserialise(bytecode);
+    }
+
+    // The domain: [0, 1] for -P, the integrand's own hyper-rectangle for -F, the unit cube for -f
+    const IntegrandInfo* integrand = (integrandName.empty() || useExpression) ? nullptr : findIntegrand(integrandName);
+    if (integrand != nullptr && dimension == 0) {
+        dimension = integrand->defaultDimension;
     }
+    if (useExpression && dimension == 0) {
+        dimension = program.dimension;
+    }
+    bool validIntegrand = useExpression ? (dimension >= program.dimension && dimension <= MAX_DIMENSION)
+                        : integrandName.empty() ? (P == 1 || P == 2) : (integrand != nullptr && integrand->supports(dimension));
+    double lower[MAX_DIMENSION] = {0.0}, upper[MAX_DIMENSION] = {1.0};
+    if (useExpression) {
+        cubeDomain(dimension, 0.0, 1.0, lower, upper);
+    } else if (integrand == nullptr) {
+        dimension = 1;
+    } else if (validIntegrand) {
+        integrand->domain(dimension, lower, upper);
+    }
+    Domain domain(dimension, lower, upper);
 
-    if ((P != 1 && P != 2) || N <= 0) {
+    // N counts integrand evaluations: each uniform costs one (two if antithetic) and K uniforms make an observation.
+    // With a target error N is optional and caps the run.
+    bool adaptive = absoluteTarget > 0.0 || relativeTarget > 0.0;
+    long long observations = (N > 0) ? N / (options.evaluationsPerUniform() * options.strata) : 0;
+    long long numUniforms = observations * options.strata;
+    if (adaptive && N <= 0) {
+        numUniforms = (replicas > 0) ? (1ll << SOBOL_BITS) : (1ll << 52);
+    }
+    // Sobol point j already has the top bits of its first coordinate fixed by j mod K, so remapping it into stratum
+    // j mod K would only ever sample a 1/K^2 slice of each stratum
+    bool validStrata = options.strata > 0 && options.strata <= CHUNK_SAMPLES && (options.strata & (options.strata - 1)) == 0
+                       && (replicas == 0 || options.strata == 1);
+    if (!validIntegrand || (replicas > 0 && dimension > MAX_SOBOL_DIMENSION) || numUniforms <= 0 || replicas < 0 || (replicas > 0 && numUniforms > (1ll << SOBOL_BITS)) || !validStrata
+        || (adaptive && replicas == 1)) {
         if (world_rank == 0) {
-            std::cerr << "Invalid arguments. -P should be 1 or 2, -N should be positive.\n";
+            std::cerr << "Invalid arguments. -P should be 1 or 2, -F a registered integrand with a supported -D, or -D at least"
+                      << " the coordinates of -f (at most "
+                      << MAX_SOBOL_DIMENSION << " with -Q), -N should be positive (at most 2^32 with -Q) and at least one observation"
+                      << " unless -E or -R is given, -Q should be >= 0 (and not 1 with a target), -K a power of two up to " << CHUNK_SAMPLES
+                      << " (and 1 with -Q).\n";
         }
         MPI_Finalize();
         return 1;
     }
 
-    
-    double local_sum = 0.0;
-    srand(time(NULL) + world_rank); 
+    // Every rank must draw from the same streams, so they all use rank 0's seed
+    MPI_Bcast(&seed, 1, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
+
+    // Monte Carlo simulation of chunks [first, last): this rank's share, split between its threads. Returns the
+    // packed moments (sum, sum of squares, count, ...) per Sobol replica, or a single set for plain Monte Carlo.
+    int numSets = std::max(1, replicas);
+    long long numChunks = (numUniforms + CHUNK_SAMPLES - 1) / CHUNK_SAMPLES;
+    auto sampleChunks = [&](long long first, long long last) {
+        ChunkRange range = splitChunks(last - first, world_rank, world_size);
+        range.first += first;
+        range.last += first;
+        auto integrate = [&](const auto& fill) {
+            if (useExpression) {
+                auto batch = [&](const double* const* x, int count, double* out) { program.evaluate(x, count, out); };
+                return sumMoments(batch, fill, options, domain, numUniforms, range, numThreads);
+            }
+            if (integrand != nullptr) {
+                auto batch = [&](const double* const* x, int count, double* out) { integrand->evaluate(x, dimension, count, out); };
+                return sumMoments(batch, fill, options, domain, numUniforms, range, numThreads);
+            }
+            auto batch = [&](const double* const* x, int count, double* out) {
+                #pragma omp simd
+                for (int i = 0; i < count; ++i) {
+                    out[i] = (P == 1) ? integralFunction1(x[0][i]) : integralFunction2(x[0][i]);
+                }
+            };
+            return sumMoments(batch, fill, options, domain, numUniforms, range, numThreads);
+        };
+        std::vector<long long> moments(numSets * MOMENT_WORDS);
+        for (int r = 0; r < numSets; ++r) {
+            MomentSums sums = (replicas > 0) ? integrate(SobolFill(seed, r, dimension)) : integrate(PhiloxFill{seed, dimension});
+            sums.pack(&moments[r * MOMENT_WORDS]);
+        }
+        return moments;
+    };
+
+    std::vector<long long> global_moments(numSets * MOMENT_WORDS, 0);
+    Estimate estimate;
+    if (!adaptive) {
+        std::vector<long long> local_moments = sampleChunks(0, numChunks);
+        MPI_Reduce(local_moments.data(), global_moments.data(), numSets * MOMENT_WORDS, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+    } else {
+        // Rounds: combine round r with a non-blocking all-reduce while round r + 1 is being sampled, then every
+        // rank makes the same stop decision from the same totals. The speculative round is kept, not wasted, and
+        // is capped at the chunks the totals so far predict are still needed, which bounds the overshoot.
+        std::vector<long long> round_moments(numSets * MOMENT_WORDS);
+        long long last = std::min(numChunks, roundChunks(0));
+        long long reduced = 0;
+        std::vector<long long> local_moments = sampleChunks(0, last);
+        auto lastProgress = std::chrono::steady_clock::now();
+        for (int round = 0;; ++round) {
+            MPI_Request request;
+            MPI_Iallreduce(local_moments.data(), round_moments.data(), numSets * MOMENT_WORDS, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD, &request);
+            long long nextFirst = last, nextLast = std::min(numChunks, last + roundChunks(round + 1));
+            if (reduced > 0) {
+                nextLast = std::min(nextLast, last + chunksToTarget(reduced, last, estimate.value, estimate.standardError, absoluteTarget, relativeTarget));
+            }
 
-    // Monte Carlo simulation
-    for (int i = world_rank; i < N; i += world_size) {
-        double x = static_cast<double>(rand()) / RAND_MAX;
-        local_sum += (P == 1) ? integralFunction1(x) : integralFunction2(x);
+            // Sample round r + 1 on a helper thread while this thread tests the reduction, since most MPI
+            // libraries only progress a non-blocking collective inside MPI calls
+            std::vector<long long> next_moments;
+            std::thread sampler;
+            if (nextFirst < nextLast && overlapRounds) {
+                sampler = std::thread([&] { next_moments = sampleChunks(nextFirst, nextLast); });
+            } else if (nextFirst < nextLast) {
+                next_moments = sampleChunks(nextFirst, nextLast);
+            }
+            int reduceDone = 0;
+            MPI_Test(&request, &reduceDone, MPI_STATUS_IGNORE);
+            while (!reduceDone) {
+                std::this_thread::sleep_for(std::chrono::microseconds(TEST_MICROSECONDS));
+                MPI_Test(&request, &reduceDone, MPI_STATUS_IGNORE);
+            }
+            if (sampler.joinable()) {
+                sampler.join();
+            }
+            accumulateSets(global_moments, round_moments, numSets);
+            reduced = last;
+
+            estimate = combineSets(global_moments, numSets, options.control);
+            auto now = std::chrono::steady_clock::now();
+            if (world_rank == 0 && (round == 0 || std::chrono::duration<double>(now - lastProgress).count() >= PROGRESS_SECONDS)) {
+                lastProgress = now;
+                std::cout << "    round " << round << ": " << last * CHUNK_SAMPLES / options.strata << " observations, "
+                          << estimate.value << " +/- " << estimate.standardError << std::endl;
+            }
+            bool done = round + 1 >= MIN_ROUNDS && targetReached(estimate.value, estimate.standardError, absoluteTarget, relativeTarget);
+            if (next_moments.empty()) {
+                break;
+            }
+            if (done) {
+                MPI_Allreduce(next_moments.data(), round_moments.data(), numSets * MOMENT_WORDS, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+                accumulateSets(global_moments, round_moments, numSets);
+                break;
+            }
+            local_moments.swap(next_moments);
+            last = nextLast;
+        }
     }
 
-    double global_sum;
-    MPI_Reduce(&local_sum, &global_sum, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
 
- 
     if (world_rank == 0) {
-        double integral = (global_sum / N);
-        std::cout << "The estimate for integral " << P << " is " << integral << std::endl;
+        estimate = combineSets(global_moments, numSets, options.control);
+        MomentSums totals;
+        totals.unpack(global_moments.data());
+        observations = totals.count;
+
+        if (useExpression) {
+            std::cout << "The estimate for " << expressionText << " over [0, 1]^" << dimension << " is " << estimate.value;
+        } else if (integrand != nullptr) {
+            std::cout << "The estimate for " << integrand->name << " in " << dimension << " dimensions is " << estimate.value;
+        } else {
+            std::cout << "The estimate for integral " << P << " is " << estimate.value;
+        }
+        if (replicas != 1) {
+            std::cout << " +/- " << estimate.standardError;
+        }
+        if (replicas > 0) {
+            std::cout << " (" << replicas << " scrambled Sobol replica" << (replicas > 1 ? "s" : "") << ")";
+        }
+        std::cout << " (seed " << seed << ")" << std::endl;
+        if (adaptive && !targetReached(estimate.value, estimate.standardError, absoluteTarget, relativeTarget)) {
+            std::cout << "    Target error not reached within the sample limit" << std::endl;
+        }
+        std::cout << "    " << observations * options.strata * options.evaluationsPerUniform() << " evaluations" << (replicas > 0 ? " per replica, " : ", ") << observations
+                  << " observations of " << options.strata << " strata" << (options.antithetic ? ", antithetic" : "");
+        if (options.tilt != 0.0) {
+            std::cout << ", importance tilt " << options.tilt;
+        }
+        if (options.control) {
+            std::cout << ", control coefficient " << estimate.controlCoefficient;
+        }
+        std::cout << std::endl;
+        double exact = (integrand != nullptr) ? integrand->exact(dimension) : std::nan("");
+        if (std::isfinite(exact)) {
+            std::cout << "    Exact value " << exact << ", error " << estimate.value - exact << std::endl;
+        }
         std::cout << "Bye!" << std::endl;
     }
 